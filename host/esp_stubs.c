@@ -0,0 +1,434 @@
+// Minimal ESP-IDF / FreeRTOS runtime for running the display code on a PC.
+// Time is virtual: vTaskDelay() advances the clock instead of sleeping, so
+// animations render at full speed while their timing logic still works.
+// SPI transactions complete immediately and are decoded by st7789_emu.c.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+#include "esp_random.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "esp_sntp.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "st7789_emu.h"
+#include "esp_stubs.h"
+
+// --- Time ---
+static int64_t virtual_us;
+static bool realtime;
+static int64_t realtime_base_us;
+
+static int64_t host_monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void host_clock_realtime(bool enable) {
+    if (enable && !realtime) {
+        realtime_base_us = host_monotonic_us();
+    } else if (!enable && realtime) {
+        virtual_us += host_monotonic_us() - realtime_base_us;
+    }
+    realtime = enable;
+}
+
+int64_t esp_timer_get_time(void) {
+    return virtual_us + (realtime ? host_monotonic_us() - realtime_base_us : 0);
+}
+
+void vTaskDelay(TickType_t t) {
+    virtual_us += (int64_t)t * 1000;
+}
+
+void vTaskDelayUntil(TickType_t *prev, TickType_t inc) {
+    *prev += inc;
+    int64_t now = esp_timer_get_time();
+    if ((int64_t)*prev * 1000 > now) {
+        virtual_us += (int64_t)*prev * 1000 - now;
+    }
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+// Wall clock on the virtual clock, as newlib's runs on the RTC. It starts at
+// a fixed date so the status bar is the same in every snapshot, and setting
+// it never touches the host's clock.
+#define HOST_WALL_START_S 1704110400 // 2024-01-01 12:00:00 UTC
+static int64_t wall_offset_us = (int64_t)HOST_WALL_START_S * 1000000;
+
+int gettimeofday(struct timeval *tv, void *tz) {
+    (void)tz;
+    int64_t us = wall_offset_us + esp_timer_get_time();
+    tv->tv_sec = (time_t)(us / 1000000);
+    tv->tv_usec = (suseconds_t)(us % 1000000);
+    return 0;
+}
+
+int settimeofday(const struct timeval *tv, const struct timezone *tz) {
+    (void)tz;
+    wall_offset_us = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec - esp_timer_get_time();
+    return 0;
+}
+
+struct esp_timer {
+    esp_timer_create_args_t args;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out) {
+    *out = calloc(1, sizeof(struct esp_timer));
+    (*out)->args = *args;
+    return ESP_OK;
+}
+
+// Host timers never fire; nothing in the snapshot path depends on them
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t t, uint64_t period_us) { (void)t; (void)period_us; return ESP_OK; }
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t us) { (void)t; (void)us; return ESP_OK; }
+esp_err_t esp_timer_stop(esp_timer_handle_t t) { (void)t; return ESP_OK; }
+esp_err_t esp_timer_delete(esp_timer_handle_t t) { free(t); return ESP_OK; }
+
+// --- Heap ---
+void *heap_caps_malloc(size_t size, unsigned caps) { (void)caps; return malloc(size); }
+void *heap_caps_calloc(size_t n, size_t size, unsigned caps) { (void)caps; return calloc(n, size); }
+void heap_caps_free(void *p) { free(p); }
+
+// --- GPIO ---
+// DC level latched by the driver's pre-transfer callback
+static int host_dc_level = 1;
+
+esp_err_t gpio_config(const gpio_config_t *c) { (void)c; return ESP_OK; }
+
+esp_err_t gpio_set_level(gpio_num_t n, uint32_t level) {
+    if (n == ST7789_EMU_DC_PIN) {
+        host_dc_level = level ? 1 : 0;
+    }
+    return ESP_OK;
+}
+
+// Encoder inputs idle high (pulled up, button released)
+int gpio_get_level(gpio_num_t n) { (void)n; return 1; }
+esp_err_t gpio_set_direction(gpio_num_t n, gpio_mode_t m) { (void)n; (void)m; return ESP_OK; }
+esp_err_t gpio_set_pull_mode(gpio_num_t n, gpio_pull_mode_t m) { (void)n; (void)m; return ESP_OK; }
+esp_err_t gpio_set_intr_type(gpio_num_t n, gpio_int_type_t t) { (void)n; (void)t; return ESP_OK; }
+esp_err_t gpio_install_isr_service(int flags) { (void)flags; return ESP_OK; }
+esp_err_t gpio_isr_handler_add(gpio_num_t n, gpio_isr_t h, void *arg) { (void)n; (void)h; (void)arg; return ESP_OK; }
+esp_err_t gpio_isr_handler_remove(gpio_num_t n) { (void)n; return ESP_OK; }
+
+// --- SPI ---
+#define HOST_SPI_QUEUE 16
+
+struct spi_device_t {
+    spi_device_interface_config_t cfg;
+    spi_transaction_t *done[HOST_SPI_QUEUE];
+    int head;
+    int count;
+};
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan) {
+    (void)host; (void)config; (void)dma_chan;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle) {
+    (void)host;
+    *handle = calloc(1, sizeof(struct spi_device_t));
+    (*handle)->cfg = *config;
+    st7789_emu_reset();
+    return ESP_OK;
+}
+
+static void host_spi_execute(spi_device_handle_t handle, spi_transaction_t *t) {
+    if (handle->cfg.pre_cb) {
+        handle->cfg.pre_cb(t);
+    }
+    const uint8_t *data = (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : t->tx_buffer;
+    st7789_emu_transfer(data, t->length / 8, host_dc_level, handle->cfg.clock_speed_hz);
+    if (handle->cfg.post_cb) {
+        handle->cfg.post_cb(t);
+    }
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+    host_spi_execute(handle, trans);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans) {
+    host_spi_execute(handle, trans);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait) {
+    (void)wait;
+    if (handle->count == HOST_SPI_QUEUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    host_spi_execute(handle, trans);
+    handle->done[(handle->head + handle->count) % HOST_SPI_QUEUE] = trans;
+    handle->count++;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait) {
+    (void)wait;
+    if (handle->count == 0) {
+        return ESP_ERR_TIMEOUT;
+    }
+    *trans = handle->done[handle->head];
+    handle->head = (handle->head + 1) % HOST_SPI_QUEUE;
+    handle->count--;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait) { (void)handle; (void)wait; return ESP_OK; }
+void spi_device_release_bus(spi_device_handle_t handle) { (void)handle; }
+
+// --- FreeRTOS ---
+// Tasks are not scheduled on the host; callers drive the code they need directly.
+BaseType_t xTaskCreate(TaskFunction_t f, const char *n, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *h) {
+    (void)f; (void)n; (void)stack; (void)arg; (void)prio;
+    if (h) {
+        *h = NULL;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t f, const char *n, uint32_t stack, void *arg, UBaseType_t prio,
+                                   TaskHandle_t *h, BaseType_t core) {
+    (void)core;
+    return xTaskCreate(f, n, stack, arg, prio, h);
+}
+
+void vTaskDelete(TaskHandle_t h) { (void)h; }
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return NULL; }
+
+static uint32_t notify_value;
+
+BaseType_t xTaskNotify(TaskHandle_t h, uint32_t v, eNotifyAction a) {
+    (void)h;
+    switch (a) {
+        case eSetBits: notify_value |= v; break;
+        case eIncrement: notify_value++; break;
+        case eSetValueWithOverwrite: notify_value = v; break;
+        default: break;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t h, uint32_t v, eNotifyAction a, BaseType_t *woken) {
+    (void)woken;
+    return xTaskNotify(h, v, a);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t h) { return xTaskNotify(h, 0, eIncrement); }
+void vTaskNotifyGiveFromISR(TaskHandle_t h, BaseType_t *woken) { (void)woken; xTaskNotify(h, 0, eIncrement); }
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+    (void)wait;
+    uint32_t v = notify_value;
+    notify_value = clear ? 0 : (v ? v - 1 : 0);
+    return v;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clr_entry, uint32_t clr_exit, uint32_t *val, TickType_t wait) {
+    (void)wait;
+    notify_value &= ~clr_entry;
+    if (val) {
+        *val = notify_value;
+    }
+    notify_value &= ~clr_exit;
+    return pdPASS;
+}
+
+struct QueueDefinition {
+    uint8_t *items;
+    UBaseType_t len;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item) {
+    QueueHandle_t q = calloc(1, sizeof(struct QueueDefinition));
+    q->items = calloc(len ? len : 1, item ? item : 1);
+    q->len = len;
+    q->item_size = item;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    (void)wait;
+    if (q->count == q->len) {
+        return pdFAIL;
+    }
+    if (q->item_size && item) {
+        memcpy(q->items + ((q->head + q->count) % q->len) * q->item_size, item, q->item_size);
+    }
+    q->count++;
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken) {
+    (void)woken;
+    return xQueueSend(q, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    (void)wait;
+    if (q->count == 0) {
+        return pdFAIL;
+    }
+    if (q->item_size && item) {
+        memcpy(item, q->items + q->head * q->item_size, q->item_size);
+    }
+    q->head = (q->head + 1) % q->len;
+    q->count--;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    return q->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    SemaphoreHandle_t s = xQueueCreate(1, 0);
+    xQueueSend(s, NULL, 0);
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return xQueueCreate(1, 0);
+}
+
+// Single-threaded host: a take that would block simply succeeds
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+    (void)wait;
+    xQueueReceive(s, NULL, 0);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    return xQueueSend(s, NULL, 0);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t *woken) {
+    (void)woken;
+    return xSemaphoreGive(s);
+}
+
+struct EventGroupDef {
+    EventBits_t bits;
+};
+
+EventGroupHandle_t xEventGroupCreate(void) {
+    return calloc(1, sizeof(struct EventGroupDef));
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t b) { return g->bits |= b; }
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t b) { EventBits_t old = g->bits; g->bits &= ~b; return old; }
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g) { return g->bits; }
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t b, BaseType_t clr, BaseType_t all, TickType_t wait) {
+    (void)all; (void)wait;
+    EventBits_t bits = g->bits;
+    if (clr) {
+        g->bits &= ~b;
+    }
+    return bits;
+}
+
+// --- Logging, Wi-Fi, NVS ---
+static vprintf_like_t log_vprintf = vprintf;
+
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func) {
+    vprintf_like_t prev = log_vprintf;
+    log_vprintf = func;
+    return prev;
+}
+
+void esp_log_write(int level, const char *tag, const char *fmt, ...) {
+    va_list args;
+    (void)level;
+    (void)tag;
+    va_start(args, fmt);
+    log_vprintf(fmt, args);
+    va_end(args);
+}
+
+uint32_t esp_log_timestamp(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+esp_event_base_t const WIFI_EVENT = "WIFI_EVENT";
+esp_event_base_t const IP_EVENT = "IP_EVENT";
+
+esp_err_t esp_event_loop_create_default(void) { return ESP_OK; }
+esp_err_t esp_event_handler_register(esp_event_base_t b, int32_t id, esp_event_handler_t h, void *arg) {
+    (void)b; (void)id; (void)h; (void)arg;
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_init(void) { return ESP_OK; }
+esp_netif_t *esp_netif_create_default_wifi_sta(void) { return NULL; }
+
+static wifi_mode_t wifi_mode = WIFI_MODE_NULL;
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *c) { (void)c; return ESP_OK; }
+esp_err_t esp_wifi_set_mode(wifi_mode_t m) { wifi_mode = m; return ESP_OK; }
+esp_err_t esp_wifi_get_mode(wifi_mode_t *m) { *m = wifi_mode; return ESP_OK; }
+esp_err_t esp_wifi_set_config(wifi_interface_t i, wifi_config_t *c) { (void)i; (void)c; return ESP_OK; }
+esp_err_t esp_wifi_start(void) { return ESP_OK; }
+esp_err_t esp_wifi_stop(void) { return ESP_OK; }
+esp_err_t esp_wifi_connect(void) { return ESP_OK; }
+esp_err_t esp_wifi_disconnect(void) { return ESP_OK; }
+
+esp_err_t nvs_flash_init(void) { return ESP_OK; }
+esp_err_t nvs_flash_erase(void) { return ESP_OK; }
+
+// Empty storage that forgets what is written
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out) {
+    (void)name; (void)mode;
+    *out = 1;
+    return ESP_OK;
+}
+esp_err_t nvs_get_i64(nvs_handle_t h, const char *key, int64_t *out) { (void)h; (void)key; (void)out; return ESP_ERR_NVS_NOT_FOUND; }
+esp_err_t nvs_set_i64(nvs_handle_t h, const char *key, int64_t value) { (void)h; (void)key; (void)value; return ESP_OK; }
+esp_err_t nvs_commit(nvs_handle_t h) { (void)h; return ESP_OK; }
+void nvs_close(nvs_handle_t h) { (void)h; }
+
+// No network: SNTP never syncs
+static bool sntp_enabled;
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode) { (void)mode; }
+void esp_sntp_setservername(uint8_t idx, const char *server) { (void)idx; (void)server; }
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t cb) { (void)cb; }
+void esp_sntp_init(void) { sntp_enabled = true; }
+bool esp_sntp_enabled(void) { return sntp_enabled; }
+
+// Deterministic so snapshots of the audio demo are reproducible
+uint32_t esp_random(void) {
+    static uint32_t state = 0x12345678;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
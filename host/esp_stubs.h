@@ -0,0 +1,11 @@
+#ifndef ESP_STUBS_H
+#define ESP_STUBS_H
+
+#include <stdbool.h>
+
+// By default the host clock only advances in vTaskDelay(), which keeps
+// animations and snapshots deterministic. Benchmarks need real elapsed time,
+// so this adds the host's monotonic clock on top while enabled.
+void host_clock_realtime(bool enable);
+
+#endif // ESP_STUBS_H
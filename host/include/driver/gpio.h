@@ -0,0 +1,36 @@
+// Host stand-in for the ESP-IDF <driver/gpio.h> header (see host/st7789_emu.h)
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_attr.h"
+typedef int gpio_num_t;
+#define GPIO_NUM_NC -1
+#define GPIO_NUM_4 4
+#define GPIO_NUM_5 5
+#define GPIO_NUM_16 16
+#define GPIO_NUM_17 17
+#define GPIO_NUM_18 18
+#define GPIO_NUM_23 23
+#define GPIO_NUM_27 27
+#define GPIO_NUM_32 32
+#define GPIO_NUM_33 33
+typedef enum { GPIO_MODE_INPUT = 1, GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+typedef enum { GPIO_PULLUP_DISABLE, GPIO_PULLUP_ENABLE } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE, GPIO_PULLDOWN_ENABLE } gpio_pulldown_t;
+typedef enum { GPIO_PULLUP_ONLY, GPIO_PULLDOWN_ONLY, GPIO_FLOATING } gpio_pull_mode_t;
+typedef enum { GPIO_INTR_DISABLE, GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE, GPIO_INTR_ANYEDGE } gpio_int_type_t;
+typedef struct { uint64_t pin_bit_mask; gpio_mode_t mode; gpio_pullup_t pull_up_en; gpio_pulldown_t pull_down_en; gpio_int_type_t intr_type; } gpio_config_t;
+typedef void (*gpio_isr_t)(void *);
+esp_err_t gpio_config(const gpio_config_t *c);
+esp_err_t gpio_set_level(gpio_num_t n, uint32_t level);
+int gpio_get_level(gpio_num_t n);
+esp_err_t gpio_set_direction(gpio_num_t n, gpio_mode_t m);
+esp_err_t gpio_set_pull_mode(gpio_num_t n, gpio_pull_mode_t m);
+esp_err_t gpio_set_intr_type(gpio_num_t n, gpio_int_type_t t);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t n, gpio_isr_t h, void *arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t n);
+
+#endif // HOST_DRIVER_GPIO_H
@@ -0,0 +1,11 @@
+// Host stand-in for the ESP-IDF <esp_attr.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define DMA_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define EXT_RAM_BSS_ATTR
+
+#endif // HOST_ESP_ATTR_H
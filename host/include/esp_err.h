@@ -0,0 +1,28 @@
+// Host stand-in for the ESP-IDF <esp_err.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_TIMEOUT 0x107
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NVS_NO_FREE_PAGES 0x1100
+#define ESP_ERR_NVS_NEW_VERSION_FOUND 0x1101
+#define ESP_ERR_NVS_NOT_FOUND 0x1102
+#define ESP_ERROR_CHECK(x) do {                                                   \
+        esp_err_t __err = (x);                                                    \
+        if (__err != ESP_OK) {                                                    \
+            fprintf(stderr, "ESP_ERROR_CHECK failed: 0x%x at %s:%d\n", __err,      \
+                    __FILE__, __LINE__);                                          \
+            abort();                                                              \
+        }                                                                         \
+    } while (0)
+static inline const char *esp_err_to_name(esp_err_t e) { (void)e; return "ERR"; }
+
+#endif // HOST_ESP_ERR_H
@@ -0,0 +1,16 @@
+// Host stand-in for the ESP-IDF <esp_heap_caps.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+void *heap_caps_malloc(size_t size, unsigned caps);
+void *heap_caps_calloc(size_t n, size_t size, unsigned caps);
+void heap_caps_free(void *p);
+
+#endif // HOST_ESP_HEAP_CAPS_H
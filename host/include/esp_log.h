@@ -0,0 +1,21 @@
+// Host stand-in for the ESP-IDF <esp_log.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+typedef int (*vprintf_like_t)(const char *, va_list);
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func);
+
+// Like ESP-IDF, every log line goes through the installed vprintf
+void esp_log_write(int level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+uint32_t esp_log_timestamp(void);
+
+#define ESP_LOGE(tag, fmt, ...) esp_log_write(1, tag, "E (%u) %s: " fmt "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) esp_log_write(2, tag, "W (%u) %s: " fmt "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) esp_log_write(3, tag, "I (%u) %s: " fmt "\n", (unsigned)esp_log_timestamp(), tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do {} while (0)
+
+#endif // HOST_ESP_LOG_H
@@ -0,0 +1,17 @@
+// Host stand-in for the ESP-IDF <esp_netif.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_NETIF_H
+#define HOST_ESP_NETIF_H
+
+#include <stdint.h>
+#include "esp_err.h"
+typedef struct esp_netif_obj esp_netif_t;
+typedef struct { uint32_t addr; } esp_ip4_addr_t;
+typedef struct { esp_ip4_addr_t ip, netmask, gw; } esp_netif_ip_info_t;
+typedef struct { esp_netif_ip_info_t ip_info; } ip_event_got_ip_t;
+#define IPSTR "%d.%d.%d.%d"
+#define IP2STR(a) (int)((a)->addr & 0xff), (int)(((a)->addr >> 8) & 0xff), (int)(((a)->addr >> 16) & 0xff), (int)(((a)->addr >> 24) & 0xff)
+enum { IP_EVENT_STA_GOT_IP };
+esp_err_t esp_netif_init(void);
+esp_netif_t *esp_netif_create_default_wifi_sta(void);
+
+#endif // HOST_ESP_NETIF_H
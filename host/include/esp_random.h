@@ -0,0 +1,8 @@
+// Host stand-in for the ESP-IDF <esp_random.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_RANDOM_H
+#define HOST_ESP_RANDOM_H
+
+#include <stdint.h>
+uint32_t esp_random(void);
+
+#endif // HOST_ESP_RANDOM_H
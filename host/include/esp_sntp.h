@@ -0,0 +1,16 @@
+// Host stand-in for the ESP-IDF <esp_sntp.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_SNTP_H
+#define HOST_ESP_SNTP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/time.h>
+typedef enum { ESP_SNTP_OPMODE_POLL } esp_sntp_operatingmode_t;
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode);
+void esp_sntp_setservername(uint8_t idx, const char *server);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t cb);
+void esp_sntp_init(void);
+bool esp_sntp_enabled(void);
+
+#endif // HOST_ESP_SNTP_H
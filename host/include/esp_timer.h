@@ -0,0 +1,19 @@
+// Host stand-in for the ESP-IDF <esp_timer.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+int64_t esp_timer_get_time(void);
+typedef struct esp_timer *esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void *arg);
+typedef enum { ESP_TIMER_TASK } esp_timer_dispatch_t;
+typedef struct { esp_timer_cb_t callback; void *arg; esp_timer_dispatch_t dispatch_method; const char *name; bool skip_unhandled_events; } esp_timer_create_args_t;
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t t, uint64_t period_us);
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t us);
+esp_err_t esp_timer_stop(esp_timer_handle_t t);
+esp_err_t esp_timer_delete(esp_timer_handle_t t);
+
+#endif // HOST_ESP_TIMER_H
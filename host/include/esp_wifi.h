@@ -0,0 +1,29 @@
+// Host stand-in for the ESP-IDF <esp_wifi.h> header (see host/st7789_emu.h)
+#ifndef HOST_ESP_WIFI_H
+#define HOST_ESP_WIFI_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+typedef enum { WIFI_MODE_NULL, WIFI_MODE_STA } wifi_mode_t;
+typedef enum { WIFI_IF_STA } wifi_interface_t;
+typedef enum { WIFI_FAST_SCAN } wifi_scan_method_t;
+typedef enum { WIFI_CONNECT_AP_BY_SIGNAL } wifi_sort_method_t;
+typedef enum { WIFI_AUTH_OPEN } wifi_auth_mode_t;
+typedef struct { int8_t rssi; wifi_auth_mode_t authmode; } wifi_scan_threshold_t;
+typedef struct { uint8_t ssid[32]; uint8_t password[64]; wifi_scan_method_t scan_method; wifi_sort_method_t sort_method; wifi_scan_threshold_t threshold; } wifi_sta_config_t;
+typedef union { wifi_sta_config_t sta; } wifi_config_t;
+typedef struct { int dummy; } wifi_init_config_t;
+#define WIFI_INIT_CONFIG_DEFAULT() { 0 }
+enum { WIFI_EVENT_STA_START, WIFI_EVENT_STA_CONNECTED, WIFI_EVENT_STA_DISCONNECTED };
+esp_err_t esp_wifi_init(const wifi_init_config_t *c);
+esp_err_t esp_wifi_set_mode(wifi_mode_t m);
+esp_err_t esp_wifi_get_mode(wifi_mode_t *m);
+esp_err_t esp_wifi_set_config(wifi_interface_t i, wifi_config_t *c);
+esp_err_t esp_wifi_start(void);
+esp_err_t esp_wifi_stop(void);
+esp_err_t esp_wifi_connect(void);
+esp_err_t esp_wifi_disconnect(void);
+
+#endif // HOST_ESP_WIFI_H
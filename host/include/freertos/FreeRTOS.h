@@ -0,0 +1,34 @@
+// Host stand-in for the ESP-IDF <freertos/FreeRTOS.h> header (see host/st7789_emu.h)
+#ifndef HOST_FREERTOS_FREERTOS_H
+#define HOST_FREERTOS_FREERTOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portTICK_PERIOD_MS 1
+#define portYIELD_FROM_ISR(...) do {} while (0)
+#define BIT0 (1u << 0)
+#define BIT1 (1u << 1)
+#define BIT2 (1u << 2)
+#define BIT3 (1u << 3)
+#define BIT4 (1u << 4)
+#define BIT5 (1u << 5)
+#define BIT6 (1u << 6)
+#define BIT7 (1u << 7)
+#define configASSERT(x) do {} while (0)
+#define portMUX_TYPE int
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(m) do { (void)(m); } while (0)
+#define portEXIT_CRITICAL(m) do { (void)(m); } while (0)
+#define portENTER_CRITICAL_ISR(m) do { (void)(m); } while (0)
+#define portEXIT_CRITICAL_ISR(m) do { (void)(m); } while (0)
+
+#endif // HOST_FREERTOS_FREERTOS_H
@@ -0,0 +1,14 @@
+// Host stand-in for the ESP-IDF <freertos/event_groups.h> header (see host/st7789_emu.h)
+#ifndef HOST_FREERTOS_EVENT_GROUPS_H
+#define HOST_FREERTOS_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+typedef struct EventGroupDef *EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t b);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t b);
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t b, BaseType_t clr, BaseType_t all, TickType_t wait);
+
+#endif // HOST_FREERTOS_EVENT_GROUPS_H
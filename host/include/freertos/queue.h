@@ -0,0 +1,13 @@
+// Host stand-in for the ESP-IDF <freertos/queue.h> header (see host/st7789_emu.h)
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+typedef struct QueueDefinition *QueueHandle_t;
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait);
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *item, BaseType_t *woken);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+
+#endif // HOST_FREERTOS_QUEUE_H
@@ -0,0 +1,23 @@
+// Host stand-in for the ESP-IDF <freertos/task.h> header (see host/st7789_emu.h)
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+void vTaskDelay(TickType_t t);
+void vTaskDelayUntil(TickType_t *prev, TickType_t inc);
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskCreate(TaskFunction_t f, const char *n, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *h);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t f, const char *n, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *h, BaseType_t core);
+void vTaskDelete(TaskHandle_t h);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+typedef enum { eNoAction, eSetBits, eIncrement, eSetValueWithOverwrite } eNotifyAction;
+BaseType_t xTaskNotify(TaskHandle_t h, uint32_t v, eNotifyAction a);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t h, uint32_t v, eNotifyAction a, BaseType_t *woken);
+BaseType_t xTaskNotifyGive(TaskHandle_t h);
+void vTaskNotifyGiveFromISR(TaskHandle_t h, BaseType_t *woken);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+BaseType_t xTaskNotifyWait(uint32_t clr_entry, uint32_t clr_exit, uint32_t *val, TickType_t wait);
+
+#endif // HOST_FREERTOS_TASK_H
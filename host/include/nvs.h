@@ -0,0 +1,15 @@
+// Host stand-in for the ESP-IDF <nvs.h> header (see host/st7789_emu.h)
+#ifndef HOST_NVS_H
+#define HOST_NVS_H
+
+#include <stdint.h>
+#include "esp_err.h"
+typedef uint32_t nvs_handle_t;
+typedef enum { NVS_READONLY, NVS_READWRITE } nvs_open_mode_t;
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out);
+esp_err_t nvs_get_i64(nvs_handle_t h, const char *key, int64_t *out);
+esp_err_t nvs_set_i64(nvs_handle_t h, const char *key, int64_t value);
+esp_err_t nvs_commit(nvs_handle_t h);
+void nvs_close(nvs_handle_t h);
+
+#endif // HOST_NVS_H
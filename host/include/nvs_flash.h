@@ -0,0 +1,9 @@
+// Host stand-in for the ESP-IDF <nvs_flash.h> header (see host/st7789_emu.h)
+#ifndef HOST_NVS_FLASH_H
+#define HOST_NVS_FLASH_H
+
+#include "esp_err.h"
+esp_err_t nvs_flash_init(void);
+esp_err_t nvs_flash_erase(void);
+
+#endif // HOST_NVS_FLASH_H
@@ -0,0 +1,272 @@
+// Renders the app's screens through the real driver into the ST7789 emulator
+// and reports the bus cost of each one. Snapshots can be dumped as PPM files
+// and compared against a golden set, so rendering changes can be checked on a
+// PC before flashing.
+//
+//   render_host [-m direct|framebuffer|band|indexed] [-o out_dir] [-g golden_dir]
+//
+// Every mode draws the same pixels, so one golden set (host/golden) serves all.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "tft_driver.h"
+#include "st7789_emu.h"
+#include "esp_stubs.h"
+#include "esp_log.h"
+#include "tft_bench.h"
+#include "tft_terminal.h"
+#include "pipboy_menu.h"
+#include "pipboy_clock.h"
+
+void app_main(void);
+void draw_please_stand_by(void);
+void draw_boot_progress(uint32_t frame);
+void draw_full_menu(int selectedIndex);
+void update_menu_selection(int oldIndex, int newIndex);
+void draw_sub_menu(menu_id_t list, int selectedIndex, bool initialDraw);
+void show_audio_demo(bool running);
+void draw_shutdown_sequence(bool isFinal);
+void draw_system_log(void);
+void draw_status_bar(bool full);
+
+typedef struct {
+    const char *name;
+    void (*setup)(void); // Unmeasured state the screen draws on top of
+    void (*draw)(void);
+    bool bench;          // False for screens whose time is mostly animation delays
+} host_screen_t;
+
+static void screen_blank(void) {
+    tft_fill_screen(0);
+    tft_flush();
+}
+
+static void screen_menu_wifi(void) {
+    tft_terminal_close();
+    draw_full_menu(0);
+    tft_flush();
+}
+
+static void screen_menu_audio(void) {
+    draw_full_menu(1);
+    tft_flush();
+}
+
+static void draw_stand_by(void) { draw_please_stand_by(); }
+// One spinner step of the boot readout over the splash
+static void draw_splash_frame(void) { draw_boot_progress(1); }
+static void draw_menu_wifi(void) { draw_full_menu(0); }
+static void draw_wifi_select(void) { draw_sub_menu(MENU_WIFI, 1, false); }
+static void draw_menu_nav(void) { update_menu_selection(0, 1); }
+static void draw_menu_power(void) { draw_full_menu(2); }
+static void draw_shutdown(void) { draw_shutdown_sequence(true); }
+
+static void draw_audio_frame(void) { show_audio_demo(true); }
+
+// The system log view, opened from the Wi-Fi sub-menu
+static void draw_log_open(void) { draw_system_log(); }
+
+static void log_fill(void) {
+    for (int i = 0; i < 30; i++) {
+        tft_terminal_printf("I (%d) HOST: filler line %d\n", i * 10, i);
+    }
+}
+
+// Power modes on the main menu: dimmed keeps the status bar in 8 colours
+static void draw_dimmed(void) {
+    tft_set_idle_mode(true);
+    tft_set_partial_area(0, 17);
+}
+
+static void screen_asleep(void) {
+    screen_menu_wifi();
+    tft_sleep();
+}
+
+// Waking must restore the menu from panel RAM without any redraw
+static void draw_wake(void) {
+    tft_wake();
+    tft_set_partial_area(-1, -1);
+    tft_set_idle_mode(false);
+}
+
+// One new line once the view is full: a scroll plus one text row
+static void draw_log_line(void) { tft_terminal_write("W (999) HOST: one more line\n"); }
+
+// One frame slot later, so the amplitude pulse has moved on
+static void audio_wait(void) { vTaskDelay(40); }
+
+// Status bar updates: nothing changed, then the clock's next minute
+static void draw_status(void) { draw_status_bar(false); }
+static void minute_wait(void) { vTaskDelay(60 * 1000); }
+
+// 12:59 -> 13:00 changes two runs of the clock on either side of the ':'
+static void hour_wait(void) {
+    screen_menu_wifi();
+    settimeofday(&(struct timeval){.tv_sec = 1704113940}, NULL); // 2024-01-01 12:59:00 UTC
+    draw_status_bar(false);
+    tft_flush();
+    vTaskDelay(60 * 1000);
+}
+
+static const host_screen_t screens[] = {
+    {"stand_by",    screen_blank,      draw_stand_by,     true},
+    {"splash_frame", draw_stand_by,    draw_splash_frame, true},
+    {"menu_wifi",   screen_blank,      draw_menu_wifi,    true},
+    {"wifi_select", NULL,              draw_wifi_select,  true},
+    {"menu_audio",  screen_blank,      screen_menu_audio, true},
+    {"menu_nav",    screen_menu_wifi,  draw_menu_nav,     true},
+    {"audio_frame", audio_wait,        draw_audio_frame,  true},
+    {"audio_next",  audio_wait,        draw_audio_frame,  true},
+    {"menu_power",  screen_blank,      draw_menu_power,   true},
+    {"shutdown",    screen_blank,      draw_shutdown,     false},
+    {"dimmed",      screen_menu_wifi,  draw_dimmed,       false},
+    {"wake",        screen_asleep,     draw_wake,         false},
+    {"log_open",    screen_menu_wifi,  draw_log_open,     true},
+    {"log_line",    log_fill,          draw_log_line,     true},
+    {"status_idle", screen_menu_wifi,  draw_status,       true},
+    {"status_tick", minute_wait,       draw_status,       true},
+    {"status_hour", hour_wait,         draw_status,       true},
+};
+
+static void bench_setup(void *arg) {
+    const host_screen_t *s = arg;
+    if (s->setup) {
+        s->setup();
+    }
+}
+
+static void bench_draw(void *arg) {
+    ((const host_screen_t *)arg)->draw();
+}
+
+static void run_benchmarks(void) {
+    tft_bench_primitives(20);
+    for (size_t i = 0; i < sizeof(screens) / sizeof(screens[0]); i++) {
+        if (!screens[i].bench) {
+            continue;
+        }
+        tft_bench_case("screen", screens[i].name, bench_setup, bench_draw, (void *)&screens[i], 20);
+    }
+    tft_bench_trig(200);
+}
+
+static int parse_mode(const char *s, tft_render_mode_t *mode) {
+    if (strcmp(s, "direct") == 0) {
+        *mode = TFT_MODE_DIRECT;
+    } else if (strcmp(s, "framebuffer") == 0 || strcmp(s, "fb") == 0) {
+        *mode = TFT_MODE_FRAMEBUFFER;
+    } else if (strcmp(s, "band") == 0) {
+        *mode = TFT_MODE_BAND;
+    } else if (strcmp(s, "indexed") == 0) {
+        *mode = TFT_MODE_INDEXED;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    tft_render_mode_t mode = TFT_MODE_DIRECT;
+    const char *out_dir = NULL;
+    const char *golden_dir = NULL;
+    bool bench = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:o:g:b")) != -1) {
+        switch (opt) {
+            case 'm':
+                if (parse_mode(optarg, &mode) != 0) {
+                    fprintf(stderr, "unknown mode '%s'\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'o':
+                out_dir = optarg;
+                break;
+            case 'g':
+                golden_dir = optarg;
+                break;
+            case 'b':
+                bench = true;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-m direct|framebuffer|band|indexed] [-o out_dir] [-g golden_dir] [-b]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (out_dir && mkdir(out_dir, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "can't create %s: %s\n", out_dir, strerror(errno));
+        return 2;
+    }
+
+    // Boot the app as on the target (tasks are not started on the host, so
+    // the clock that the boot task sets up is started here)
+    app_main();
+    clock_init(NULL);
+
+    // Kept out of the on-screen log, so the log screens match in every mode
+    vprintf_like_t log_vprintf = esp_log_set_vprintf(vprintf);
+    tft_set_render_mode(mode);
+    esp_log_set_vprintf(log_vprintf);
+
+    if (bench) {
+        host_clock_realtime(true);
+        run_benchmarks();
+        host_clock_realtime(false);
+        return 0;
+    }
+
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(screens) / sizeof(screens[0]); i++) {
+        const host_screen_t *s = &screens[i];
+        char path[512];
+
+        if (s->setup) {
+            s->setup();
+        }
+        tft_wait_done();
+        st7789_emu_clear_stats();
+
+        s->draw();
+        tft_flush();
+        tft_wait_done();
+
+        const st7789_emu_stats_t *st = st7789_emu_stats();
+        printf("screen=%s transactions=%u bytes=%u commands=%u pixels=%u caset=%u raset=%u bus_us=%.0f\n",
+               s->name, (unsigned)st->transactions, (unsigned)st->bytes, (unsigned)st->commands,
+               (unsigned)st->pixels, (unsigned)st->cmd_count[0x2A], (unsigned)st->cmd_count[0x2B],
+               st->bus_ns / 1000.0);
+        if (st->timing_violations) {
+            printf("TIMING screen=%s violations=%u\n", s->name, (unsigned)st->timing_violations);
+            failures++;
+        }
+
+        if (out_dir) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", out_dir, s->name);
+            if (st7789_emu_write_ppm(path) != 0) {
+                fprintf(stderr, "can't write %s\n", path);
+                failures++;
+            }
+        }
+
+        if (golden_dir) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, s->name);
+            int diff = st7789_emu_compare_ppm(path);
+            if (diff != 0) {
+                printf("MISMATCH screen=%s pixels=%d (%s)\n", s->name, diff, path);
+                failures++;
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
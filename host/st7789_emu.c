@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <string.h>
+#include "st7789_emu.h"
+#include "esp_timer.h"
+
+#define CMD_SWRESET 0x01
+#define CMD_SLPIN   0x10
+#define CMD_SLPOUT  0x11
+#define CMD_PTLON   0x12
+#define CMD_NORON   0x13
+#define CMD_DISPOFF 0x28
+#define CMD_DISPON  0x29
+#define CMD_CASET   0x2A
+#define CMD_RASET   0x2B
+#define CMD_RAMWR   0x2C
+#define CMD_PTLAR   0x30
+#define CMD_VSCRDEF 0x33
+#define CMD_MADCTL  0x36
+#define CMD_VSCSAD  0x37
+#define CMD_IDMOFF  0x38
+#define CMD_IDMON   0x39
+#define CMD_COLMOD  0x3A
+
+// Datasheet spacing around SLPIN/SLPOUT
+#define SLEEP_SETTLE_US 120000
+#define SLEEP_CMD_US    5000
+
+// Chip-select to chip-select overhead of one queued transaction on the ESP32
+#define TRANS_SETUP_NS 8000
+
+static uint16_t gram[ST7789_EMU_GRAM_H][ST7789_EMU_GRAM_W];
+static st7789_emu_stats_t stats;
+
+static uint8_t cmd;
+static uint8_t params[16];
+static int param_count;
+static int xs, xe, ys, ye;
+static int col, row;
+static int half_pixel = -1; // First byte of a pixel split across transfers
+static bool sleeping;
+static bool display_on;
+static uint8_t madctl;
+static int tfa, vsa, ssa;    // Vertical scroll definition and start address
+static bool scrolling;       // Vertical scroll mode (entered by VSCSAD, left by NORON)
+static bool idle;
+static bool partial;
+static int psl, pel;         // Partial area rows
+static int64_t sleep_cmd_us; // Time of the last SLPIN/SLPOUT
+
+void st7789_emu_reset(void) {
+    memset(gram, 0, sizeof(gram));
+    cmd = 0;
+    param_count = 0;
+    xs = 0;
+    xe = ST7789_EMU_GRAM_W - 1;
+    ys = 0;
+    ye = ST7789_EMU_GRAM_H - 1;
+    col = row = 0;
+    half_pixel = -1;
+    sleeping = true;
+    display_on = false;
+    madctl = 0;
+    tfa = 0;
+    vsa = ST7789_EMU_GRAM_H;
+    ssa = 0;
+    scrolling = false;
+    idle = false;
+    partial = false;
+    psl = 0;
+    pel = ST7789_EMU_GRAM_H - 1;
+    sleep_cmd_us = -SLEEP_SETTLE_US;
+}
+
+static void emu_command(uint8_t c) {
+    int64_t now = esp_timer_get_time();
+    if (now - sleep_cmd_us < SLEEP_CMD_US ||
+        ((c == CMD_SLPIN || c == CMD_SLPOUT) && now - sleep_cmd_us < SLEEP_SETTLE_US)) {
+        stats.timing_violations++;
+    }
+
+    cmd = c;
+    param_count = 0;
+    half_pixel = -1;
+    stats.commands++;
+    stats.cmd_count[c]++;
+
+    switch (c) {
+        case CMD_SWRESET:
+            sleeping = true;
+            display_on = false;
+            tfa = ssa = 0;
+            vsa = ST7789_EMU_GRAM_H;
+            scrolling = false;
+            idle = false;
+            partial = false;
+            sleep_cmd_us = now;
+            break;
+        case CMD_NORON:
+            scrolling = false;
+            partial = false;
+            break;
+        case CMD_SLPIN:
+            sleeping = true;
+            sleep_cmd_us = now;
+            break;
+        case CMD_SLPOUT:
+            sleeping = false;
+            sleep_cmd_us = now;
+            break;
+        case CMD_PTLON:
+            partial = true;
+            scrolling = false;
+            break;
+        case CMD_IDMOFF:
+            idle = false;
+            break;
+        case CMD_IDMON:
+            idle = true;
+            break;
+        case CMD_DISPOFF:
+            display_on = false;
+            break;
+        case CMD_DISPON:
+            display_on = true;
+            break;
+        case CMD_RAMWR:
+            col = xs;
+            row = ys;
+            break;
+    }
+}
+
+static void emu_pixel(uint16_t px) {
+    if (row < ST7789_EMU_GRAM_H && col < ST7789_EMU_GRAM_W) {
+        gram[row][col] = px;
+    }
+    stats.pixels++;
+
+    if (++col > xe) {
+        col = xs;
+        if (++row > ye) {
+            row = ys;
+        }
+    }
+}
+
+static void emu_param(uint8_t b) {
+    if (cmd == CMD_RAMWR) {
+        if (half_pixel < 0) {
+            half_pixel = b;
+        } else {
+            emu_pixel((uint16_t)(half_pixel << 8 | b));
+            half_pixel = -1;
+        }
+        return;
+    }
+
+    if (param_count < (int)sizeof(params)) {
+        params[param_count] = b;
+    }
+    param_count++;
+
+    switch (cmd) {
+        case CMD_CASET:
+            if (param_count == 4) {
+                xs = params[0] << 8 | params[1];
+                xe = params[2] << 8 | params[3];
+            }
+            break;
+        case CMD_RASET:
+            if (param_count == 4) {
+                ys = params[0] << 8 | params[1];
+                ye = params[2] << 8 | params[3];
+            }
+            break;
+        case CMD_MADCTL:
+            madctl = params[0];
+            break;
+        case CMD_PTLAR:
+            if (param_count == 4) {
+                psl = params[0] << 8 | params[1];
+                pel = params[2] << 8 | params[3];
+            }
+            break;
+        case CMD_VSCRDEF:
+            if (param_count == 6) {
+                tfa = params[0] << 8 | params[1];
+                vsa = params[2] << 8 | params[3];
+            }
+            break;
+        case CMD_VSCSAD:
+            if (param_count == 2) {
+                ssa = params[0] << 8 | params[1];
+                scrolling = true;
+            }
+            break;
+    }
+}
+
+void st7789_emu_transfer(const uint8_t *data, size_t len, int dc, int clock_hz) {
+    stats.transactions++;
+    stats.bytes += len;
+    stats.bus_ns += TRANS_SETUP_NS + (uint64_t)len * 8 * 1000000000ull / (clock_hz ? clock_hz : 40000000);
+
+    for (size_t i = 0; i < len; i++) {
+        if (dc == 0) {
+            emu_command(data[i]);
+        } else {
+            emu_param(data[i]);
+        }
+    }
+}
+
+const st7789_emu_stats_t *st7789_emu_stats(void) {
+    return &stats;
+}
+
+void st7789_emu_clear_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+uint16_t st7789_emu_pixel(int x, int y) {
+    if (sleeping || !display_on) {
+        return 0;
+    }
+    if (partial && (y < psl || y > pel)) {
+        return 0; // Non-display area
+    }
+    if (scrolling && vsa > 0 && y >= tfa && y < tfa + vsa) {
+        y = tfa + (y - tfa + ssa - tfa + vsa) % vsa;
+    }
+
+    uint16_t px = gram[y][x];
+    if (idle) {
+        // 8-colour mode: each channel is reduced to its top bit
+        px = ((px & 0x8000) ? 0xF800 : 0) | ((px & 0x0400) ? 0x07E0 : 0) | ((px & 0x0010) ? 0x001F : 0);
+    }
+    return px;
+}
+
+int st7789_emu_write_ppm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", ST7789_EMU_VIS_W, ST7789_EMU_VIS_H);
+    for (int y = 0; y < ST7789_EMU_VIS_H; y++) {
+        for (int x = 0; x < ST7789_EMU_VIS_W; x++) {
+            uint16_t px = st7789_emu_pixel(x, y);
+            uint8_t rgb[3] = {
+                (uint8_t)(((px >> 11) & 0x1F) * 255 / 31),
+                (uint8_t)(((px >> 5) & 0x3F) * 255 / 63),
+                (uint8_t)((px & 0x1F) * 255 / 31),
+            };
+            fwrite(rgb, 1, sizeof(rgb), f);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+int st7789_emu_compare_ppm(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+
+    int w, h, maxval;
+    if (fscanf(f, "P6 %d %d %d", &w, &h, &maxval) != 3 || w != ST7789_EMU_VIS_W ||
+        h != ST7789_EMU_VIS_H || fgetc(f) == EOF) {
+        fclose(f);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            uint8_t rgb[3];
+            if (fread(rgb, 1, sizeof(rgb), f) != sizeof(rgb)) {
+                fclose(f);
+                return -1;
+            }
+            uint16_t px = st7789_emu_pixel(x, y);
+            if (rgb[0] != ((px >> 11) & 0x1F) * 255 / 31 ||
+                rgb[1] != ((px >> 5) & 0x3F) * 255 / 63 ||
+                rgb[2] != (px & 0x1F) * 255 / 31) {
+                mismatches++;
+            }
+        }
+    }
+    fclose(f);
+    return mismatches;
+}
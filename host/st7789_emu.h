@@ -0,0 +1,50 @@
+#ifndef ST7789_EMU_H
+#define ST7789_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Host-side ST7789 model. The stand-in SPI layer (host/esp_stubs.c) feeds every
+// transaction into st7789_emu_transfer() together with the DC level the
+// driver's pre-transfer callback set, and the emulator decodes the command
+// stream into an in-memory frame memory. Window addressing, sleep, display
+// on/off, vertical scrolling, partial and idle modes are modelled.
+
+#define ST7789_EMU_GRAM_W  320
+#define ST7789_EMU_GRAM_H  320  // Frame memory rows (the panel shows 240)
+#define ST7789_EMU_VIS_W   320
+#define ST7789_EMU_VIS_H   240
+#define ST7789_EMU_DC_PIN  16   // Must match TFT_DC in main/tft_driver.c
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t commands;
+    uint32_t pixels;         // Pixels written by RAMWR
+    uint32_t cmd_count[256];
+    uint64_t bus_ns;         // Estimated wire time including per-transaction setup
+    uint32_t timing_violations; // Commands sent too soon after SLPIN/SLPOUT/SWRESET
+} st7789_emu_stats_t;
+
+// Power-on state: black frame memory, sleeping, display off
+void st7789_emu_reset(void);
+
+// Feeds one SPI transaction. `dc` is the DC line level during the transfer.
+void st7789_emu_transfer(const uint8_t *data, size_t len, int dc, int clock_hz);
+
+const st7789_emu_stats_t *st7789_emu_stats(void);
+void st7789_emu_clear_stats(void);
+
+// RGB565 value currently shown at visible pixel (x, y), honouring display
+// on/off, sleep, partial area, idle colours and vertical scrolling.
+uint16_t st7789_emu_pixel(int x, int y);
+
+// Binary PPM (P6) of the visible screen; returns 0 on success
+int st7789_emu_write_ppm(const char *path);
+
+// Compares the visible screen against a PPM written by st7789_emu_write_ppm().
+// Returns the number of differing pixels, or -1 if the file can't be read.
+int st7789_emu_compare_ppm(const char *path);
+
+#endif // ST7789_EMU_H
@@ -1,10 +1,8 @@
 #include <stdio.h>
-#include <math.h> 
 #include <string.h> 
 #include <stdlib.h> 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/queue.h"
 #include "freertos/event_groups.h" 
 #include "freertos/semphr.h" 
 #include "esp_log.h"
@@ -16,9 +14,17 @@
 #include "esp_random.h" 
 #include "driver/gpio.h"
 #include "tft_driver.h"
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
+#include "tft_terminal.h"
+#include "tft_assets.h"
+#include "tft_sched.h"
+#include "tft_wave.h"
+#include "fx_math.h"
+#include "pipboy_menu.h"
+#include "pipboy_clock.h"
+#include "pipboy_boot.h"
+#include "pipboy_bus.h"
+#if CONFIG_TFT_BENCH
+#include "tft_bench.h"
 #endif
 
 // --- Configuration ---
@@ -30,6 +36,25 @@
 #define CONFIG_PIPBOY_PASSWORD "25670980"
 #endif
 
+// Inactivity on a static screen before the panel dims / sleeps (0 = never)
+#ifndef CONFIG_PIPBOY_DIM_TIMEOUT_S
+#define CONFIG_PIPBOY_DIM_TIMEOUT_S 30
+#endif
+
+#ifndef CONFIG_PIPBOY_SLEEP_TIMEOUT_S
+#define CONFIG_PIPBOY_SLEEP_TIMEOUT_S 120
+#endif
+
+// Shortest time the splash stays up once drawn (0 = dismiss as soon as ready)
+#ifndef CONFIG_PIPBOY_SPLASH_MIN_MS
+#define CONFIG_PIPBOY_SPLASH_MIN_MS 600
+#endif
+
+// Panel TE output (-1 = not wired, frames are paced by a timer)
+#ifndef CONFIG_TFT_TE_GPIO
+#define CONFIG_TFT_TE_GPIO -1
+#endif
+
 // --- PIN Definitions ---
 #define ROTARY_ENCODER_CLK_PIN GPIO_NUM_32
 #define ROTARY_ENCODER_DT_PIN  GPIO_NUM_33
@@ -42,37 +67,122 @@
 
 static const char *TAG = "PIPBOY_APP";
 
-// --- Global State Variables ---
-static bool isSystemHalted = false;
-static bool isDemoActive = false;
-static bool isSubMenuActive = false;
-static bool isBrokerConnected = false;
-static int currentMenuIndex = 0;
-static int currentSubMenuIndex = 0;
-
-// Menu items
-static const char* menuItems[] = {
-    "1. WIFI",
-    "2. AUDIO", 
-    "3. POWER"
-};
-static const int menuSize = 3;
+// What a sub-menu row currently shows, so scrolling repaints only the rows
+// whose selection or status changed (geometry comes from the menu layout)
+typedef struct {
+    bool selected;
+    menu_status_t status;
+} sub_row_state_t;
 
-// WiFi sub-menu items
-static const char* wifiSubMenuItems[] = {
-    "1. CONNECT WIFI",
-    "2. CONNECT BROKER",
-    "3. BACK"
-};
-static const int wifiSubMenuSize = 3;
+static sub_row_state_t subMenuShown[MENU_MAX_CHILDREN];
+
+// Nav bar items as drawn. A detent marks only the two items whose selection
+// changed, and the content pane is redrawn only when the tab changed.
+typedef struct {
+    bool selected;
+    bool dirty;
+} nav_widget_t;
+
+static nav_widget_t navWidgets[MENU_MAX_CHILDREN];
+static int paneTab = -1; // Tab whose view fills the content pane, -1 = none
 
 // --- FreeRTOS Handles ---
-static QueueHandle_t encoder_queue;
-static SemaphoreHandle_t tft_mutex;
 static EventGroupHandle_t wifi_event_group;
 const int WIFI_CONNECTED_BIT = BIT0;
 const int WIFI_FAIL_BIT = BIT1;
 
+// --- Panel Power State ---
+typedef enum {
+    PANEL_ACTIVE,
+    PANEL_DIMMED,  // Idle colours, only the status bar driven
+    PANEL_ASLEEP,
+} panel_power_t;
+
+#define STATUS_BAR_HEIGHT 18
+
+// Menu content area, between the status bar and the nav bar
+#define CONTENT_TOP    20
+#define CONTENT_HEIGHT (TFT_HEIGHT - 50)
+
+static panel_power_t panelPower = PANEL_ACTIVE;
+static uint64_t last_input_ms = 0;
+
+// --- UI State ---
+// Changed only by the encoder task (and app_main before it starts), in
+// uiInput. ui_publish() copies it whole to uiShared under ui_lock before
+// marking the render dirty bits; the render task copies uiShared to ui at
+// the start of each pass and draws only from ui. A change that touches
+// several fields (opening a sub-menu, waking from halt) is never seen half
+// done.
+typedef struct {
+    bool isBooting;          // Splash up until the system is ready
+    bool isSystemHalted;
+    bool isDemoActive;
+    bool isSubMenuActive;
+    bool isLogActive;
+    bool isBrokerConnected;
+    int currentMenuIndex;
+    int currentSubMenuIndex;
+    panel_power_t panelRequested; // panelPower follows it
+} ui_state_t;
+
+static ui_state_t uiInput = {.isBooting = true};
+static ui_state_t uiShared = {.isBooting = true};
+static ui_state_t ui = {.isBooting = true};
+static portMUX_TYPE ui_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void ui_publish(uint32_t dirty) {
+    portENTER_CRITICAL(&ui_lock);
+    uiShared = uiInput;
+    portEXIT_CRITICAL(&ui_lock);
+    bus_mark_dirty(BUS_RENDER, dirty);
+}
+
+// --- Status Bar ---
+// Fields as last drawn. Updates redraw only the characters that changed, so a
+// minute tick usually sends one or two glyphs and nothing is sent between ticks.
+typedef enum {
+    STATUS_BROKER,
+    STATUS_WIFI,
+    STATUS_TIME,
+    STATUS_FIELD_COUNT
+} status_field_id_t;
+
+#define STATUS_TEXT_Y    5
+#define STATUS_FIELD_LEN 5
+
+typedef struct {
+    int16_t x;
+    char text[STATUS_FIELD_LEN + 1];
+    uint16_t color;
+} status_field_t;
+
+static status_field_t statusFields[STATUS_FIELD_COUNT] = {
+    [STATUS_BROKER] = {.x = TFT_WIDTH - 150},
+    [STATUS_WIFI]   = {.x = TFT_WIDTH - 110},
+    [STATUS_TIME]   = {.x = TFT_WIDTH - 45},
+};
+static bool statusBarShown = false; // On screen and matching statusFields
+
+// --- Screens ---
+// Only the render task draws. Input, Wi-Fi, the clock and the frame scheduler
+// change the UI state and mark render dirty bits on the bus (BUS_DIRTY_*);
+// the render task then brings the panel to the screen that state calls for.
+// Any number of changes between two frames make one redraw.
+typedef enum {
+    SCREEN_NONE,
+    SCREEN_SPLASH,    // Animated by the frame scheduler until booting ends
+    SCREEN_MENU,      // Nav bar and the current tab's view
+    SCREEN_SUB_MENU,  // Current tab's list, rows selectable
+    SCREEN_LOG,
+    SCREEN_AUDIO,     // Animated by the frame scheduler until the button stops it
+    SCREEN_HALTED,
+} screen_t;
+
+#define RENDER_LOG_POLL_MS 20 // New log output is drawn at most this late
+
+static volatile uint32_t splashFrame = 0; // Latest splash slot, for BUS_DIRTY_FRAME
+
 // --- Encoder State ---
 static volatile int32_t encoder_value = 0;
 static volatile uint8_t last_encoder_state = 0;
@@ -82,18 +192,79 @@ static const uint32_t ENCODER_DEBOUNCE_MS = 50; // Reduced for better responsive
 // WiFi state
 static int wifi_status = 0; // 0=disconnected, 1=connecting, 2=connected
 
+// --- Boot ---
+// Brought up by boot_system_task while app_main initializes the panel
+#define BOOT_SYSTEM_PHASES (BOOT_BIT(BOOT_PHASE_NVS) | BOOT_BIT(BOOT_PHASE_CLOCK) | BOOT_BIT(BOOT_PHASE_NETWORK))
+
+// Boot readout in the splash's bottom-left corner
+#define SPLASH_PROGRESS_X 5
+#define SPLASH_PROGRESS_Y (TFT_HEIGHT - 12)
+#define SPLASH_FRAME_RATE 10 // Spinner steps per second
+
+static int splashProgressWidth = 0; // Width of the readout on screen
+
 // --- Function Prototypes ---
 void draw_please_stand_by(void);
+void draw_boot_progress(uint32_t frame);
+static void splash_frame(const tft_sched_frame_t *frame, void *arg);
 void draw_full_menu(int selectedIndex);
 void show_menu_content(int index);
 void update_menu_selection(int oldIndex, int newIndex);
-void run_menu_action(int index);
-void draw_wifi_sub_menu(int selectedIndex, bool initialDraw);
-void handle_wifi_sub_menu_toggle(int index);
+void draw_sub_menu(menu_id_t list, int selectedIndex, bool initialDraw);
+static void menu_open(menu_id_t node);
+static void menu_back(menu_id_t node);
+static void audio_demo_start(menu_id_t node);
+static void system_halt(menu_id_t node);
+static void wifi_toggle(menu_id_t node);
+static void broker_toggle(menu_id_t node);
+static void system_log_open(menu_id_t node);
+static void wifi_status_text(menu_status_t *out);
+static void broker_status_text(menu_status_t *out);
+static void view_sub_menu(menu_id_t tab);
+static void view_audio(menu_id_t tab);
+static void view_power(menu_id_t tab);
 void show_audio_demo(bool running);
+static void audio_demo_frame(const tft_sched_frame_t *frame, void *arg);
+void draw_system_log(void);
 void show_power_screen(void);
 void draw_shutdown_sequence(bool isFinal);
-void draw_clock(void);
+void draw_status_bar(bool full);
+void panel_set_power(panel_power_t state);
+void update_panel_power(void);
+#if CONFIG_TFT_BENCH
+void run_display_benchmarks(void);
+#endif
+
+// --- Menu Dispatch ---
+// What the ids in the menu tree (pipboy_menu.c) do in this app
+static const menu_action_fn menuActions[MENU_ACTION_COUNT] = {
+    [MENU_ACTION_OPEN] = menu_open,
+    [MENU_ACTION_BACK] = menu_back,
+    [MENU_ACTION_AUDIO_DEMO] = audio_demo_start,
+    [MENU_ACTION_HALT] = system_halt,
+    [MENU_ACTION_WIFI_TOGGLE] = wifi_toggle,
+    [MENU_ACTION_BROKER_TOGGLE] = broker_toggle,
+    [MENU_ACTION_SYSTEM_LOG] = system_log_open,
+};
+
+static const menu_status_fn menuStatus[MENU_STATUS_COUNT] = {
+    [MENU_STATUS_WIFI] = wifi_status_text,
+    [MENU_STATUS_BROKER] = broker_status_text,
+};
+
+static const menu_view_fn menuViews[MENU_VIEW_COUNT] = {
+    [MENU_VIEW_LIST] = view_sub_menu,
+    [MENU_VIEW_AUDIO] = view_audio,
+    [MENU_VIEW_POWER] = view_power,
+};
+
+// Tab selected in the nav bar; its children form the sub-menu
+static menu_id_t current_tab(const ui_state_t *state) {
+    return menu_child(MENU_ROOT, state->currentMenuIndex);
+}
+static void request_screen_refresh(void);
+static void status_changed(bool save_due);
+void render_task(void *pvParameter);
 
 // Encoder functions
 static uint8_t read_encoder_state(void);
@@ -101,7 +272,11 @@ void encoder_task(void *pvParameter);
 static void gpio_isr_handler(void* arg); // Declaration without IRAM_ATTR
 void init_rotary_encoder(void);
 
+// Boot functions
+static void boot_system_task(void *pvParameter);
+
 // WiFi functions  
+static void wifi_stack_init(void);
 void wifi_connection_task(void *pvParameter);
 static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
 
@@ -109,45 +284,97 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
 //                             I N I T I A L I Z A T I O N
 // =========================================================================
 
-void app_main(void) {
-    // Initialize NVS
+// Storage, clock and network stack. None of it touches the display, so it
+// runs while app_main sits in the panel's reset and sleep-out delays.
+static void boot_system_task(void *pvParameter) {
+    boot_phase_begin(BOOT_PHASE_NVS);
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
         ESP_ERROR_CHECK(nvs_flash_erase());
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+    boot_phase_end(BOOT_PHASE_NVS);
+
+    boot_phase_begin(BOOT_PHASE_CLOCK);
+    clock_init(status_changed);
+    boot_phase_end(BOOT_PHASE_CLOCK);
+
+    // The Wi-Fi driver reads its calibration data from NVS
+    boot_phase_begin(BOOT_PHASE_NETWORK);
+    wifi_stack_init();
+    boot_phase_end(BOOT_PHASE_NETWORK);
+
+    vTaskDelete(NULL);
+}
+
+void app_main(void) {
+    // Keep recent log output for the on-screen system log
+    tft_terminal_attach_log();
+    boot_init();
 
     // Initialize synchronization primitives
-    tft_mutex = xSemaphoreCreateMutex();
-    encoder_queue = xQueueCreate(20, sizeof(int32_t)); // Larger queue
     wifi_event_group = xEventGroupCreate();
 
-    if (!tft_mutex || !encoder_queue || !wifi_event_group) {
+    if (!wifi_event_group) {
         ESP_LOGE(TAG, "Failed to create FreeRTOS objects");
         return;
     }
 
+    xTaskCreate(boot_system_task, "boot", 4096, NULL, 5, NULL);
+
     // Initialize hardware
     init_rotary_encoder();
+    boot_phase_begin(BOOT_PHASE_PANEL);
     tft_init_driver();
+    boot_phase_end(BOOT_PHASE_PANEL);
+
+    boot_phase_begin(BOOT_PHASE_RENDER);
+    menu_layout_init();
 
-    // Draw splash screen
-    if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
-        draw_please_stand_by();
-        xSemaphoreGive(tft_mutex);
+#if CONFIG_TFT_RENDER_FRAMEBUFFER
+    if (tft_set_render_mode(TFT_MODE_FRAMEBUFFER) != ESP_OK) {
+        ESP_LOGW(TAG, "Framebuffer unavailable, drawing directly to the panel");
     }
+#elif CONFIG_TFT_RENDER_BAND
+    tft_set_render_mode(TFT_MODE_BAND);
+#elif CONFIG_TFT_RENDER_INDEXED
+    if (tft_set_render_mode(TFT_MODE_INDEXED) != ESP_OK) {
+        ESP_LOGW(TAG, "Indexed framebuffer unavailable, using the band renderer");
+        tft_set_render_mode(TFT_MODE_BAND);
+    }
+#endif
+
+    ESP_ERROR_CHECK(tft_sched_init(CONFIG_TFT_TE_GPIO));
+    boot_phase_end(BOOT_PHASE_RENDER);
+
+#if CONFIG_TFT_BENCH
+    run_display_benchmarks();
+#endif
+
+    // From here on the render task owns the display
+    xTaskCreate(render_task, "render", 4096, NULL, 8, NULL);
+
+    // The splash stays up only until the system phases have ended
+    boot_phase_begin(BOOT_PHASE_SPLASH);
+    bus_mark_dirty(BUS_RENDER, BUS_DIRTY_BOOT);
+    boot_wait(BOOT_SYSTEM_PHASES | BOOT_BIT(BOOT_PHASE_SPLASH), portMAX_DELAY);
+
+    int64_t shown_ms = (esp_timer_get_time() - boot_phase_end_us(BOOT_PHASE_SPLASH)) / 1000;
+    if (shown_ms < CONFIG_PIPBOY_SPLASH_MIN_MS) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_PIPBOY_SPLASH_MIN_MS - shown_ms));
+    }
+
+    // Replace the splash with the initial menu. Published before the encoder
+    // task starts, which owns the UI state from then on.
+    boot_phase_begin(BOOT_PHASE_INTERACTIVE);
+    uiInput.isBooting = false;
+    ui_publish(BUS_DIRTY_BOOT);
 
     // Create tasks
     xTaskCreate(encoder_task, "encoder", 4096, NULL, 10, NULL); // Increased stack
     xTaskCreate(wifi_connection_task, "wifi", 4096, NULL, 6, NULL);
 
-    // Draw initial menu
-    if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
-        draw_full_menu(currentMenuIndex);
-        xSemaphoreGive(tft_mutex);
-    }
-
     ESP_LOGI(TAG, "Pip-Boy started successfully");
 }
 
@@ -165,8 +392,8 @@ static void IRAM_ATTR gpio_isr_handler(void* arg) {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     
     if (gpio_num == ROTARY_ENCODER_SW_PIN) {
-        int32_t button_press = -1;
-        xQueueSendFromISR(encoder_queue, &button_press, &xHigherPriorityTaskWoken);
+        bus_msg_t msg = {.type = BUS_MSG_INPUT, .input = {ENC_DIR_NONE, true}};
+        bus_post_from_isr(BUS_LOGIC, &msg, &xHigherPriorityTaskWoken);
     }
     
     if (xHigherPriorityTaskWoken) {
@@ -202,18 +429,68 @@ void init_rotary_encoder(void) {
     ESP_LOGI(TAG, "Rotary encoder initialized");
 }
 
+// Runs on the encoder task. State changes only; the render task draws the result.
+static void handle_input(const encoder_event_t *event) {
+    uint64_t current_time = esp_timer_get_time() / 1000;
+    if (current_time - last_encoder_process_time <= ENCODER_DEBOUNCE_MS) {
+        return;
+    }
+    last_encoder_process_time = current_time;
+    last_input_ms = current_time;
+
+    if (uiInput.panelRequested != PANEL_ACTIVE || uiInput.isSystemHalted) {
+        // The first input after a power-saving state only wakes the panel
+        uiInput.panelRequested = PANEL_ACTIVE;
+        uint32_t dirty = BUS_DIRTY_POWER;
+        if (uiInput.isSystemHalted) {
+            uiInput.isSystemHalted = false;
+            uiInput.isDemoActive = false;
+            uiInput.isSubMenuActive = false;
+            dirty |= BUS_DIRTY_HALT;
+        }
+        ui_publish(dirty);
+    } else if (event->button_press) {
+        ESP_LOGI(TAG, "Button pressed");
+        if (uiInput.isLogActive) {
+            uiInput.isLogActive = false;
+            ui_publish(BUS_DIRTY_MENU);
+        } else if (uiInput.isSubMenuActive) {
+            menu_activate(menuActions, menu_child(current_tab(&uiInput), uiInput.currentSubMenuIndex));
+        } else if (!uiInput.isDemoActive) {
+            menu_activate(menuActions, current_tab(&uiInput));
+        } else {
+            uiInput.isDemoActive = false;
+            ui_publish(BUS_DIRTY_DEMO);
+        }
+    } else { // Rotation
+        int step = (event->direction == ENC_DIR_CW) ? 1 : -1;
+
+        if (uiInput.isLogActive) {
+            // The log view only reacts to the button
+        } else if (uiInput.isSubMenuActive) {
+            uiInput.currentSubMenuIndex = menu_wrap(current_tab(&uiInput), uiInput.currentSubMenuIndex, step);
+            ui_publish(BUS_DIRTY_MENU);
+        } else if (!uiInput.isDemoActive) {
+            uiInput.currentMenuIndex = menu_wrap(MENU_ROOT, uiInput.currentMenuIndex, step);
+            ui_publish(BUS_DIRTY_MENU);
+        }
+    }
+}
+
+// Polls the rotation and handles the logic consumer's messages: input from
+// here and the button ISR, connection changes from Wi-Fi
 void encoder_task(void *pvParameter) {
     // Silence unused variable warnings
     (void)wifi_status;
-    (void)wifiSubMenuItems;
-    (void)isBrokerConnected;
-    (void)isSystemHalted;
+    (void)uiInput.isBrokerConnected;
 
     uint8_t current_state;
-    int32_t encoder_delta;
     uint64_t last_rotation_time = 0;
+    uint32_t last_dropped = 0;
     const uint32_t ROTATION_DEBOUNCE_MS = 5; // Fast rotation detection
-    
+
+    bus_register(BUS_LOGIC);
+
     while (1) {
         // Process encoder rotation with higher frequency
         current_state = read_encoder_state();
@@ -222,82 +499,247 @@ void encoder_task(void *pvParameter) {
             uint64_t current_time = esp_timer_get_time() / 1000;
             
             if (current_time - last_rotation_time > ROTATION_DEBOUNCE_MS) {
+                bus_msg_t msg = {.type = BUS_MSG_INPUT, .input = {ENC_DIR_CCW, false}};
                 // Improved quadrature decoding
                 if ((last_encoder_state == 0 && current_state == 2) ||
                     (last_encoder_state == 2 && current_state == 3) ||
                     (last_encoder_state == 3 && current_state == 1) ||
                     (last_encoder_state == 1 && current_state == 0)) {
-                    encoder_delta = 1; // CW
-                } else {
-                    encoder_delta = -1; // CCW
+                    msg.input.direction = ENC_DIR_CW;
                 }
                 
-                xQueueSend(encoder_queue, &encoder_delta, 0);
+                bus_post(BUS_LOGIC, &msg);
                 last_rotation_time = current_time;
             }
             last_encoder_state = current_state;
         }
 
-        // Process events from queue
-        int32_t event;
-        if (xQueueReceive(encoder_queue, &event, pdMS_TO_TICKS(2)) == pdTRUE) {
-            uint64_t current_time = esp_timer_get_time() / 1000;
-            
-            if (current_time - last_encoder_process_time > ENCODER_DEBOUNCE_MS) {
-                last_encoder_process_time = current_time;
-                
-                if (xSemaphoreTake(tft_mutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-                    if (event == -1) { // Button press
-                        ESP_LOGI(TAG, "Button pressed");
-                        if (isSubMenuActive && currentMenuIndex == 0) {
-                            handle_wifi_sub_menu_toggle(currentSubMenuIndex);
-                            vTaskDelay(pdMS_TO_TICKS(150));
-                            draw_wifi_sub_menu(currentSubMenuIndex, true);
-                        } else if (!isDemoActive) {
-                            run_menu_action(currentMenuIndex);
-                            vTaskDelay(pdMS_TO_TICKS(150));
-                        } else {
-                            isDemoActive = false;
-                            tft_fill_screen(ST77XX_BLACK);
-                            vTaskDelay(pdMS_TO_TICKS(150));
-                            draw_full_menu(currentMenuIndex);
-                        }
-                    } else { // Rotation
-                        int step = (event > 0) ? 1 : -1;
-                        
-                        if (isSubMenuActive && currentMenuIndex == 0) {
-                            int oldSubIndex = currentSubMenuIndex;
-                            currentSubMenuIndex = (currentSubMenuIndex + step + wifiSubMenuSize) % wifiSubMenuSize;
-                            draw_wifi_sub_menu(currentSubMenuIndex, false);
-                        } else if (!isDemoActive) {
-                            int oldMenuIndex = currentMenuIndex;
-                            currentMenuIndex = (currentMenuIndex + step + menuSize) % menuSize;
-                            update_menu_selection(oldMenuIndex, currentMenuIndex);
-                        }
-                    }
-                    xSemaphoreGive(tft_mutex);
+        // Every pending message at once: a burst of detents marks one redraw
+        uint32_t dirty = bus_wait(BUS_LOGIC, pdMS_TO_TICKS(2));
+        if (dirty & BUS_DIRTY_CLOCK) {
+            clock_save();
+        }
+        if (dirty & BUS_MSG_PENDING) {
+            bus_msg_t msg;
+            while (bus_receive(BUS_LOGIC, &msg)) {
+                if (msg.type == BUS_MSG_INPUT) {
+                    handle_input(&msg.input);
+                } else if (msg.type == BUS_MSG_WIFI) {
+                    request_screen_refresh();
                 }
             }
-        }
 
-        // Handle continuous audio demo with smoother updates
-        if (isDemoActive && !isSubMenuActive && currentMenuIndex == 1) {
-            static uint64_t last_audio_update = 0;
-            uint64_t current_time = esp_timer_get_time() / 1000;
-            
-            if (current_time - last_audio_update > 30) { // ~33 FPS
-                if (xSemaphoreTake(tft_mutex, pdMS_TO_TICKS(1)) == pdTRUE) {
-                    show_audio_demo(true);
-                    xSemaphoreGive(tft_mutex);
-                    last_audio_update = current_time;
-                }
+            bus_stats_t stats;
+            bus_get_stats(BUS_LOGIC, &stats);
+            if (stats.dropped != last_dropped) {
+                last_dropped = stats.dropped;
+                bus_log_stats();
             }
         }
 
+        update_panel_power();
+
         vTaskDelay(pdMS_TO_TICKS(1)); // Higher frequency for better responsiveness
     }
 }
 
+// =========================================================================
+//                         R E N D E R   T A S K
+// =========================================================================
+
+// Whatever is showing now, redrawn for changed status (e.g. Wi-Fi). The log
+// view and the audio demo keep only the status bar up to date.
+static void request_screen_refresh(void) {
+    if (!uiInput.isSystemHalted) {
+        bus_mark_dirty(BUS_RENDER, BUS_DIRTY_STATUS | BUS_DIRTY_MENU);
+    }
+}
+
+// Clock callback: each minute boundary, and whenever the time is set. The
+// hourly save goes to the encoder task, off the esp_timer task.
+static void status_changed(bool save_due) {
+    bus_mark_dirty(BUS_RENDER, BUS_DIRTY_STATUS);
+    if (save_due) {
+        bus_mark_dirty(BUS_LOGIC, BUS_DIRTY_CLOCK);
+    }
+}
+
+// The screen the UI state calls for
+static screen_t ui_screen(void) {
+    if (ui.isSystemHalted) return SCREEN_HALTED;
+    if (ui.isBooting) return SCREEN_SPLASH;
+    if (ui.isLogActive) return SCREEN_LOG;
+    if (ui.isSubMenuActive) return SCREEN_SUB_MENU;
+    if (ui.isDemoActive) return SCREEN_AUDIO;
+    return SCREEN_MENU;
+}
+
+// Takes down `from` and draws `to` in full
+static void screen_enter(screen_t from, screen_t to) {
+    switch (from) {
+        case SCREEN_SPLASH:
+            tft_sched_stop();
+            break;
+        case SCREEN_LOG:
+            tft_terminal_close();
+            break;
+        case SCREEN_AUDIO:
+            tft_sched_stop();
+            tft_fill_screen(ST77XX_BLACK);
+            break;
+        default:
+            break;
+    }
+
+    switch (to) {
+        case SCREEN_SPLASH:
+            statusBarShown = false;
+            draw_please_stand_by();
+            draw_boot_progress(0);
+            tft_flush();
+            boot_phase_end(BOOT_PHASE_SPLASH);
+            tft_sched_start(&(tft_sched_config_t){
+                .fps = SPLASH_FRAME_RATE,
+                .callback = splash_frame,
+                .deferred = true,
+            });
+            break;
+        case SCREEN_SUB_MENU:
+            if (from == SCREEN_MENU) {
+                // Nav bar already up: the list replaces the tab's view
+                draw_sub_menu(current_tab(&ui), ui.currentSubMenuIndex, true);
+                paneTab = -1;
+                break;
+            }
+            draw_full_menu(ui.currentMenuIndex);
+            break;
+        case SCREEN_MENU:
+            draw_full_menu(ui.currentMenuIndex);
+            if (from == SCREEN_SPLASH) {
+                tft_flush();
+                boot_phase_end(BOOT_PHASE_INTERACTIVE);
+                ESP_LOGI(TAG, "Interactive %lld ms after start",
+                         (long long)(boot_phase_end_us(BOOT_PHASE_INTERACTIVE) / 1000));
+                boot_log_timeline();
+            }
+            break;
+        case SCREEN_LOG:
+            draw_system_log();
+            break;
+        case SCREEN_AUDIO:
+            // Started from the audio tab: its pane is already clear but for
+            // the preview, which this redraws in place and resets the wave
+            show_audio_demo(false);
+            tft_sched_start(&(tft_sched_config_t){
+                .callback = audio_demo_frame,
+                .deferred = true,
+            });
+            break;
+        case SCREEN_HALTED:
+            statusBarShown = false;
+            clock_save();
+            draw_shutdown_sequence(true);
+            tft_flush();
+            vTaskDelay(pdMS_TO_TICKS(1500));
+            tft_fill_screen(ST77XX_BLACK);
+            tft_flush();
+            panel_set_power(PANEL_ASLEEP);
+            ESP_LOGW(TAG, "SYSTEM HALTED");
+            break;
+        default:
+            break;
+    }
+}
+
+// Draws what the dirty bits ask for; returns false when the frame must not
+// be flushed yet
+static bool render_dirty(uint32_t dirty) {
+    static screen_t shown = SCREEN_NONE;
+    bool flush = false;
+
+    // One consistent snapshot for the whole pass
+    portENTER_CRITICAL(&ui_lock);
+    ui = uiShared;
+    portEXIT_CRITICAL(&ui_lock);
+
+    if (dirty & BUS_DIRTY_POWER) {
+        panel_set_power(ui.panelRequested);
+        flush = true;
+    }
+
+    screen_t screen = ui_screen();
+    bool entered = screen != shown;
+    if (entered) {
+        screen_enter(shown, screen);
+        shown = screen;
+        flush = true;
+    } else if (dirty & BUS_DIRTY_MENU) {
+        // Same screen, new selection or row status
+        if (screen == SCREEN_MENU && paneTab >= 0 && paneTab != ui.currentMenuIndex) {
+            update_menu_selection(paneTab, ui.currentMenuIndex);
+            flush = true;
+        } else if (screen == SCREEN_MENU) {
+            draw_full_menu(ui.currentMenuIndex); // Status rows in the tab's view
+            flush = true;
+        } else if (screen == SCREEN_SUB_MENU) {
+            draw_sub_menu(current_tab(&ui), ui.currentSubMenuIndex, false);
+            flush = true;
+        }
+    }
+
+    if (!entered && (dirty & BUS_DIRTY_FRAME) && tft_sched_is_running()) {
+        // Last slot's frame goes out at the start of this one. A slot marked
+        // just before the animation stopped draws nothing.
+        if (screen == SCREEN_SPLASH) {
+            tft_flush();
+            draw_boot_progress(splashFrame);
+        } else if (screen == SCREEN_AUDIO) {
+            tft_flush();
+            show_audio_demo(true);
+        }
+    }
+
+    if (dirty & BUS_DIRTY_STATUS) {
+        // A sleeping panel catches up when it wakes
+        if (statusBarShown && panelPower != PANEL_ASLEEP) {
+            draw_status_bar(false);
+        }
+        // While animating, the frame scheduler flushes at its next slot
+        flush = flush || !tft_sched_is_running();
+    }
+    return flush;
+}
+
+// The only task that draws or sends panel commands. Logic tasks never wait
+// for it, so input latency doesn't depend on how long a screen takes.
+void render_task(void *pvParameter) {
+    bus_register(BUS_RENDER);
+
+    while (1) {
+        TickType_t wait = ui.isLogActive ? pdMS_TO_TICKS(RENDER_LOG_POLL_MS) : portMAX_DELAY;
+        uint32_t dirty = bus_wait(BUS_RENDER, wait);
+        bool flush = render_dirty(dirty);
+
+        // Draw log output queued since the last pass
+        if (ui.isLogActive && tft_terminal_update()) {
+            flush = true;
+        }
+
+        if (flush) {
+            tft_flush();
+        }
+
+#if CONFIG_TFT_STATS
+        if (dirty & ~BUS_DIRTY_FRAME) {
+            // Bus cost of the screen update that was just flushed
+            tft_stats_t frame_stats;
+            tft_stats_get_frame(&frame_stats);
+            tft_stats_log(&frame_stats);
+        }
+#endif
+    }
+}
+
 // =========================================================================
 //                         D I S P L A Y   F U N C T I O N S
 // =========================================================================
@@ -309,10 +751,10 @@ void draw_please_stand_by(void) {
     
     // Draw radiating lines (like Arduino version)
     for(int i = 0; i < 360; i += 15) {
-        float angle_rad = i * (M_PI / 180.0f);
+        fx_angle_t angle = FX_ANGLE_DEG(i);
         tft_draw_line(centerX, centerY, 
-                     centerX + (int)(120 * cosf(angle_rad)), 
-                     centerY + (int)(120 * sinf(angle_rad)), 
+                     centerX + FX_MUL_Q15(120, fx_cos(angle)), 
+                     centerY + FX_MUL_Q15(120, fx_sin(angle)), 
                      PB_DARK_GREEN);
     }
 
@@ -328,19 +770,80 @@ void draw_please_stand_by(void) {
     // Draw text (centered like Arduino version)
     tft_draw_text(centerX - 85, centerY - 15, "PLEASE", 3, PB_GREEN);
     tft_draw_text(centerX - 100, centerY + 20, "STAND BY", 3, PB_GREEN);
-    
-    vTaskDelay(pdMS_TO_TICKS(3000));
-    tft_fill_screen(ST77XX_BLACK);
+    tft_flush();
+    splashProgressWidth = 0;
 }
 
-void draw_clock(void) {
-    tft_draw_filled_rect(TFT_WIDTH - 80, 0, 80, 18, ST77XX_BLACK);
-    tft_draw_text(TFT_WIDTH - 45, 5, "12:00", 1, PB_GREEN);
-    
-    // Draw WiFi status like Arduino version
+// Spinner and the system phase still running, so a slow boot step (e.g. an
+// NVS erase) reads as progress rather than a hang
+void draw_boot_progress(uint32_t frame) {
+    static const char spinner[] = "|/-\\";
+    boot_phase_t pending = boot_pending(BOOT_SYSTEM_PHASES);
+    char text[24];
+
+    snprintf(text, sizeof(text), "%c %s", spinner[frame % 4],
+             pending < BOOT_PHASE_COUNT ? boot_phase_name(pending) : "READY");
+
+    // The new text may be narrower than the old one
+    int width = tft_get_text_width(text, 1);
+    if (width < splashProgressWidth) {
+        tft_draw_filled_rect(SPLASH_PROGRESS_X + width, SPLASH_PROGRESS_Y, splashProgressWidth - width,
+                             tft_get_font()->height, ST77XX_BLACK);
+    }
+    tft_draw_text_bg(SPLASH_PROGRESS_X, SPLASH_PROGRESS_Y, text, 1, PB_GREEN, ST77XX_BLACK);
+    splashProgressWidth = width;
+}
+
+static void splash_frame(const tft_sched_frame_t *frame, void *arg) {
+    splashFrame = frame->index;
+    bus_mark_dirty(BUS_RENDER, BUS_DIRTY_FRAME);
+}
+
+// Draws text over what the field shows. Monospace cells line up, so only
+// the changed characters are sent; anything else redraws the field.
+static void status_field_update(status_field_t *f, const char *text, uint16_t color, bool full) {
+    const tft_font_t *font = tft_get_font();
+
+    if (!full && color == f->color && strcmp(text, f->text) == 0) {
+        return;
+    }
+
+    if (full || color != f->color || font->metrics || strlen(text) != strlen(f->text)) {
+        if (!full && (font->metrics || strlen(text) != strlen(f->text))) {
+            // The new text may be narrower than the old one
+            tft_draw_filled_rect(f->x, STATUS_TEXT_Y, tft_get_text_width(f->text, 1), font->height, ST77XX_BLACK);
+        }
+        tft_draw_text_bg(f->x, STATUS_TEXT_Y, text, 1, color, ST77XX_BLACK);
+    } else {
+        // One run from the first changed character to the last: a single
+        // command, however many characters in between stayed the same
+        int first = 0;
+        int last = strlen(text) - 1;
+        while (text[first] == f->text[first]) {
+            first++;
+        }
+        while (text[last] == f->text[last]) {
+            last--;
+        }
+
+        char run[STATUS_FIELD_LEN + 1];
+        memcpy(run, &text[first], last - first + 1);
+        run[last - first + 1] = '\0';
+        tft_draw_text_bg(f->x + first * font->advance, STATUS_TEXT_Y, run, 1, color, ST77XX_BLACK);
+    }
+
+    snprintf(f->text, sizeof(f->text), "%s", text);
+    f->color = color;
+}
+
+// full: every field, as a retained frame must record them; otherwise only
+// what differs from the last drawn state
+void draw_status_bar(bool full) {
+    char time_text[6];
+    clock_format_hhmm(time_text);
+
     const char* wifi_text = "WIFI-";
     uint16_t wifi_color = PB_DARK_GREEN;
-    
     if (wifi_status == 2) { // Connected
         wifi_text = "WIFI+";
         wifi_color = PB_GREEN;
@@ -348,216 +851,268 @@ void draw_clock(void) {
         wifi_text = "WIFI~";
         wifi_color = PB_GREEN;
     }
-    
-    tft_draw_filled_rect(TFT_WIDTH - 120, 0, 40, 18, ST77XX_BLACK);
-    tft_draw_text(TFT_WIDTH - 110, 5, wifi_text, 1, wifi_color);
+
+    status_field_update(&statusFields[STATUS_BROKER], ui.isBrokerConnected ? "MQTT+" : "MQTT-",
+                        ui.isBrokerConnected ? PB_GREEN : PB_DARK_GREEN, full);
+    status_field_update(&statusFields[STATUS_WIFI], wifi_text, wifi_color, full);
+    status_field_update(&statusFields[STATUS_TIME], time_text, PB_GREEN, full);
+    statusBarShown = true;
+}
+
+// --- Menu ---
+static void draw_nav_item(menu_id_t id, bool selected) {
+    const menu_rect_t *r = menu_rect(id);
+    const char *label = menu_node(id)->label;
+
+    tft_draw_filled_rect(r->x, r->y, r->w, r->h, ST77XX_BLACK);
+    if (selected) {
+        tft_draw_rect(r->x + 3, r->y + 3, r->w - 6, r->h - 6, PB_GREEN);
+        tft_draw_text_bg(r->textX, r->textY, label, MENU_TEXT_SIZE, PB_GREEN, ST77XX_BLACK);
+    } else {
+        tft_draw_text_bg(r->textX, r->textY, label, MENU_TEXT_SIZE, PB_DARK_GREEN, ST77XX_BLACK);
+    }
 }
 
 void draw_full_menu(int selectedIndex) {
+    // Retained frame: only what differs from the previous menu frame is repainted
+    tft_frame_begin();
     tft_fill_screen(ST77XX_BLACK);
     
     // Top status bar (like Arduino version)
-    tft_draw_text(10, 5, "PIP-BOY MENU", 1, PB_GREEN);
-    draw_clock();
+    tft_draw_text_bg(10, 5, menu_node(MENU_ROOT)->label, 1, PB_GREEN, ST77XX_BLACK);
+    draw_status_bar(true);
     tft_draw_h_line(0, 18, TFT_WIDTH, PB_DARK_GREEN);
 
-    // Bottom navigation bar (improved centering)
-    int navY = TFT_HEIGHT - 25;
-    tft_draw_h_line(0, navY - 7, TFT_WIDTH, PB_DARK_GREEN);
-    
-    // Calculate total width for centering (like Arduino version)
-    int totalTextWidth = 0;
-    const int itemSpacing = 15;
-    for (int i = 0; i < menuSize; i++) {
-        totalTextWidth += tft_get_text_width(menuItems[i], 2) + itemSpacing;
-    }
-    totalTextWidth -= itemSpacing;
-
-    int currentX = (TFT_WIDTH - totalTextWidth) / 2;
-    int textHeight = 16;
-
-    for (int i = 0; i < menuSize; i++) {
-        int textWidth = tft_get_text_width(menuItems[i], 2);
-        
-        // Clear area (more thorough like Arduino version)
-        tft_draw_filled_rect(currentX - 5, navY - 5, textWidth + 10, textHeight + 10, ST77XX_BLACK);
-
-        if (i == selectedIndex) {
-            tft_draw_rect(currentX - 2, navY - 2, textWidth + 4, textHeight + 4, PB_GREEN);
-            tft_draw_text(currentX, navY, menuItems[i], 2, PB_GREEN);
-        } else {
-            tft_draw_text(currentX, navY, menuItems[i], 2, PB_DARK_GREEN);
-        }
-        currentX += textWidth + itemSpacing;
+    // Bottom navigation bar, every tab at its cached position
+    tft_draw_h_line(0, TFT_HEIGHT - 32, TFT_WIDTH, PB_DARK_GREEN);
+    for (int i = 0; i < menu_child_count(MENU_ROOT); i++) {
+        navWidgets[i] = (nav_widget_t){.selected = (i == selectedIndex)};
+        draw_nav_item(menu_child(MENU_ROOT, i), navWidgets[i].selected);
     }
 
     show_menu_content(selectedIndex);
+    paneTab = selectedIndex;
+    tft_frame_end();
 }
 
 void show_menu_content(int index) {
-    tft_draw_filled_rect(0, 20, TFT_WIDTH, TFT_HEIGHT - 50, ST77XX_BLACK);
-    
-    switch (index) {
-        case 0: 
-            draw_wifi_sub_menu(currentSubMenuIndex, true); 
-            break;
-        case 1: 
-            show_audio_demo(false); 
-            break;
-        case 2: 
-            show_power_screen(); 
-            break;
+    menu_id_t tab = menu_child(MENU_ROOT, index);
+    menu_view_fn view = menuViews[menu_node(tab)->view];
+
+    // Content never touches the status or nav bar. The pane is cleared
+    // here only; views draw on it as it is.
+    tft_push_clip(0, CONTENT_TOP, TFT_WIDTH, CONTENT_HEIGHT);
+    tft_draw_filled_rect(0, CONTENT_TOP, TFT_WIDTH, CONTENT_HEIGHT, ST77XX_BLACK);
+    if (view) {
+        view(tab);
     }
+    tft_pop_clip();
 }
 
+// Only over a menu drawn by draw_full_menu(): repaints the dirty nav items
+// and, for a new tab, the content pane
 void update_menu_selection(int oldIndex, int newIndex) {
-    if (oldIndex != newIndex) {
-        show_menu_content(newIndex);
-        
-        // Redraw navigation bar with new selection (like Arduino version)
-        int navY = TFT_HEIGHT - 25;
-        int totalTextWidth = 0;
-        const int itemSpacing = 15;
-        
-        for (int i = 0; i < menuSize; i++) {
-            totalTextWidth += tft_get_text_width(menuItems[i], 2) + itemSpacing;
+    if (oldIndex == newIndex) {
+        return;
+    }
+    navWidgets[oldIndex] = (nav_widget_t){.selected = false, .dirty = true};
+    navWidgets[newIndex] = (nav_widget_t){.selected = true, .dirty = true};
+
+    for (int i = 0; i < menu_child_count(MENU_ROOT); i++) {
+        if (navWidgets[i].dirty) {
+            draw_nav_item(menu_child(MENU_ROOT, i), navWidgets[i].selected);
+            navWidgets[i].dirty = false;
         }
-        totalTextWidth -= itemSpacing;
+    }
 
-        int currentX = (TFT_WIDTH - totalTextWidth) / 2;
-        int textHeight = 16;
+    if (paneTab != newIndex) {
+        show_menu_content(newIndex);
+        paneTab = newIndex;
+    }
+}
 
-        for (int i = 0; i < menuSize; i++) {
-            int textWidth = tft_get_text_width(menuItems[i], 2);
-            
-            tft_draw_filled_rect(currentX - 5, navY - 5, textWidth + 10, textHeight + 10, ST77XX_BLACK);
+// --- Menu Actions ---
+// Run by the encoder task: they change the UI state and request a redraw
 
-            if (i == newIndex) {
-                tft_draw_rect(currentX - 2, navY - 2, textWidth + 4, textHeight + 4, PB_GREEN);
-                tft_draw_text(currentX, navY, menuItems[i], 2, PB_GREEN);
-            } else {
-                tft_draw_text(currentX, navY, menuItems[i], 2, PB_DARK_GREEN);
-            }
-            currentX += textWidth + itemSpacing;
-        }
+static void menu_open(menu_id_t node) {
+    uiInput.isDemoActive = true;
+    uiInput.isSubMenuActive = true;
+    uiInput.currentSubMenuIndex = 0;
+    ui_publish(BUS_DIRTY_MENU);
+}
+
+static void menu_back(menu_id_t node) {
+    uiInput.isSubMenuActive = false;
+    uiInput.isDemoActive = false;
+    // Stop WiFi if not connected
+    if (wifi_status != 2) {
+        xEventGroupSetBits(wifi_event_group, BIT3); // Force disconnect
     }
+    ui_publish(BUS_DIRTY_MENU);
 }
 
-void run_menu_action(int index) {
-    ESP_LOGI(TAG, "Menu action: %d", index);
-    
-    switch (index) {
-        case 0: // WIFI: Enter Sub-Menu
-            isDemoActive = true;
-            isSubMenuActive = true;
-            currentSubMenuIndex = 0;
-            draw_wifi_sub_menu(currentSubMenuIndex, true);
+static void audio_demo_start(menu_id_t node) {
+    uiInput.isDemoActive = true;
+    ui_publish(BUS_DIRTY_DEMO);
+}
+
+static void system_halt(menu_id_t node) {
+    uiInput.isSystemHalted = true;
+    ui_publish(BUS_DIRTY_HALT);
+}
+
+static void view_sub_menu(menu_id_t tab) {
+    draw_sub_menu(tab, ui.currentSubMenuIndex, true);
+}
+
+static void view_audio(menu_id_t tab) {
+    show_audio_demo(false);
+}
+
+static void view_power(menu_id_t tab) {
+    show_power_screen();
+}
+
+// =========================================================================
+//                         P A N E L   P O W E R
+// =========================================================================
+
+// Render task only. Waking keeps the panel's RAM, so only status bar updates
+// skipped while asleep are drawn.
+void panel_set_power(panel_power_t state) {
+    if (state == panelPower) {
+        return;
+    }
+
+    switch (state) {
+        case PANEL_ACTIVE:
+            tft_wake();
+            tft_set_partial_area(-1, -1);
+            tft_set_idle_mode(false);
+            if (statusBarShown) {
+                draw_status_bar(false);
+            }
             break;
-            
-        case 1: // AUDIO: Enter Demo Mode
-            isDemoActive = true;
-            show_audio_demo(false);
+        case PANEL_DIMMED:
+            // Keep the status bar lit in 8 colours, switch the rest off
+            tft_set_idle_mode(true);
+            tft_set_partial_area(0, STATUS_BAR_HEIGHT - 1);
             break;
-            
-        case 2: // POWER: Halt System
-            draw_shutdown_sequence(true);
-            vTaskDelay(pdMS_TO_TICKS(1500));
-            tft_fill_screen(ST77XX_BLACK);
-            isSystemHalted = true;
-            ESP_LOGW(TAG, "SYSTEM HALTED");
+        case PANEL_ASLEEP:
+            tft_sleep();
             break;
     }
+    panelPower = state;
+}
+
+// Dims, then sleeps, the panel after inactivity on a static screen (encoder task)
+void update_panel_power(void) {
+    // The audio demo and the log view keep drawing, so they stay lit
+    bool static_screen = !uiInput.isLogActive && (!uiInput.isDemoActive || uiInput.isSubMenuActive);
+    if (uiInput.panelRequested == PANEL_ASLEEP || uiInput.isSystemHalted || !static_screen) {
+        return;
+    }
+
+    uint64_t idle_ms = esp_timer_get_time() / 1000 - last_input_ms;
+    panel_power_t target = uiInput.panelRequested;
+    if (CONFIG_PIPBOY_SLEEP_TIMEOUT_S > 0 && idle_ms >= CONFIG_PIPBOY_SLEEP_TIMEOUT_S * 1000ULL) {
+        target = PANEL_ASLEEP;
+    } else if (CONFIG_PIPBOY_DIM_TIMEOUT_S > 0 && idle_ms >= CONFIG_PIPBOY_DIM_TIMEOUT_S * 1000ULL) {
+        target = PANEL_DIMMED;
+    }
+
+    if (target != uiInput.panelRequested) {
+        ESP_LOGI(TAG, "Panel %s after %llu ms idle", target == PANEL_ASLEEP ? "asleep" : "dimmed",
+                 (unsigned long long)idle_ms);
+        uiInput.panelRequested = target;
+        ui_publish(BUS_DIRTY_POWER);
+    }
 }
 
 // =========================================================================
 //                         W I F I   S U B - M E N U
 // =========================================================================
 
-void handle_wifi_sub_menu_toggle(int index) {
-    ESP_LOGI(TAG, "WiFi sub-menu action: %d", index);
-    
-    switch (index) {
-        case 0: // CONNECT WIFI
-            xEventGroupSetBits(wifi_event_group, BIT2); // Toggle WiFi
-            break;
-            
-        case 1: // CONNECT BROKER
-            isBrokerConnected = !isBrokerConnected;
-            break;
-            
-        case 2: // BACK
-            isSubMenuActive = false;
-            isDemoActive = false;
-            // Stop WiFi if not connected
-            if (wifi_status != 2) {
-                xEventGroupSetBits(wifi_event_group, BIT3); // Force disconnect
-            }
-            vTaskDelay(pdMS_TO_TICKS(200));
-            draw_full_menu(currentMenuIndex);
-            break;
+// The Wi-Fi task redraws the rows once the connection state changes
+static void wifi_toggle(menu_id_t node) {
+    xEventGroupSetBits(wifi_event_group, BIT2); // Toggle WiFi
+}
+
+static void broker_toggle(menu_id_t node) {
+    uiInput.isBrokerConnected = !uiInput.isBrokerConnected;
+    ui_publish(BUS_DIRTY_MENU | BUS_DIRTY_STATUS);
+}
+
+static void system_log_open(menu_id_t node) {
+    uiInput.isLogActive = true;
+    ui_publish(BUS_DIRTY_MENU);
+}
+
+static void wifi_status_text(menu_status_t *out) {
+    EventBits_t bits = xEventGroupGetBits(wifi_event_group);
+
+    if (bits & WIFI_CONNECTED_BIT) {
+        *out = (menu_status_t){"ONLINE", PB_GREEN};
+        wifi_status = 2;
+    } else if (wifi_status == 1) {
+        *out = (menu_status_t){"CONNECTING...", PB_GREEN};
+    } else {
+        *out = (menu_status_t){"OFFLINE", PB_DARK_GREEN};
     }
 }
 
-void draw_wifi_sub_menu(int selectedIndex, bool initialDraw) {
-    const int startY = 50;
-    const int lineHeight = 25;
-    const int startX = 20;
+static void broker_status_text(menu_status_t *out) {
+    *out = ui.isBrokerConnected ? (menu_status_t){"ACTIVE", PB_GREEN} : (menu_status_t){"INACTIVE", PB_DARK_GREEN};
+}
+
+// Log view over the content area, opened from the Wi-Fi sub-menu
+void draw_system_log(void) {
+    tft_draw_text_bg(10, 5, "SYSTEM LOG  ", 1, PB_GREEN, ST77XX_BLACK);
+    tft_terminal_open(20, PB_GREEN, ST77XX_BLACK);
+    tft_terminal_update();
+}
+
+static void draw_sub_menu_row(menu_id_t id, const sub_row_state_t *state) {
+    const menu_rect_t *r = menu_rect(id);
+    const char *label = menu_node(id)->label;
+
+    // Clear area for the line item
+    tft_draw_filled_rect(r->x, r->y, r->w, r->h, ST77XX_BLACK);
     
+    // Opaque label first: its blank bottom rows overlap the selection frame
+    if (state->selected) {
+        tft_draw_text_bg(r->textX, r->textY, label, MENU_TEXT_SIZE, PB_GREEN, ST77XX_BLACK);
+        tft_draw_rect(r->x + 3, r->y + 3, r->w - 5, r->h - 4, PB_GREEN);
+    } else {
+        tft_draw_text_bg(r->textX, r->textY, label, MENU_TEXT_SIZE, PB_DARK_GREEN, ST77XX_BLACK);
+    }
+    
+    // Draw status indicators (like Arduino version)
+    if (state->status.text) {
+        tft_draw_text_bg(TFT_WIDTH - 75, r->textY, state->status.text, 1, state->status.color, ST77XX_BLACK);
+    }
+}
+
+// initialDraw repaints the header and every row; otherwise only rows whose
+// selection or status changed since they were drawn
+void draw_sub_menu(menu_id_t list, int selectedIndex, bool initialDraw) {
     if (initialDraw) {
         // Clear and draw header
         tft_draw_filled_rect(0, 20, TFT_WIDTH, 40, ST77XX_BLACK);
-        tft_draw_text(startX + 20, 30, "NETWORK CONFIG", 2, PB_GREEN);
-        tft_draw_h_line(startX + 20, 55, TFT_WIDTH - 80, PB_DARK_GREEN);
+        tft_draw_text_bg(40, 30, menu_node(list)->title, 2, PB_GREEN, ST77XX_BLACK);
+        tft_draw_h_line(40, 55, TFT_WIDTH - 80, PB_DARK_GREEN);
     }
 
-    // Get WiFi status
-    EventBits_t bits = xEventGroupGetBits(wifi_event_group);
-    bool is_connected = (bits & WIFI_CONNECTED_BIT) != 0;
-    const char* wifi_status_text = "OFFLINE";
-    uint16_t wifi_status_color = PB_DARK_GREEN;
-    
-    if (is_connected) {
-        wifi_status_text = "ONLINE";
-        wifi_status_color = PB_GREEN;
-        wifi_status = 2;
-    } else if (wifi_status == 1) {
-        wifi_status_text = "CONNECTING...";
-        wifi_status_color = PB_GREEN;
-    }
+    for (int i = 0; i < menu_child_count(list); i++) {
+        menu_id_t row = menu_child(list, i);
+        sub_row_state_t state = {.selected = (i == selectedIndex)};
+        menu_get_status(menuStatus, row, &state.status);
 
-    for (int i = 0; i < wifiSubMenuSize; i++) {
-        int y = startY + i * lineHeight + 40;
-        int itemW = TFT_WIDTH - startX + 5;
-        
-        // Clear area for the line item
-        tft_draw_filled_rect(startX - 5, y - 5, TFT_WIDTH - startX + 10, lineHeight + 5, ST77XX_BLACK);
-        
-        if (i == selectedIndex) {
-            tft_draw_rect(startX - 2, y - 2, itemW, lineHeight - 4, PB_GREEN);
-            tft_draw_text(startX + 10, y + 4, wifiSubMenuItems[i], 2, PB_GREEN);
-        } else {
-            tft_draw_text(startX + 10, y + 4, wifiSubMenuItems[i], 2, PB_DARK_GREEN);
-        }
-        
-        // Draw status indicators (like Arduino version)
-        const char* statusText = "";
-        uint16_t statusColor = PB_DARK_GREEN;
-
-        if (i == 0) { // WIFI STATUS
-            statusText = wifi_status_text;
-            statusColor = wifi_status_color;
-        } else if (i == 1) { // BROKER STATUS
-            statusText = isBrokerConnected ? "ACTIVE" : "INACTIVE";
-            statusColor = isBrokerConnected ? PB_GREEN : PB_DARK_GREEN;
-        } 
-        
-        if (i < 2) {
-            tft_draw_text(TFT_WIDTH - 75, y + 4, statusText, 1, statusColor);
-        }
-        
-        // Show IP if connected (like Arduino version)
-        if (i == 0 && is_connected) {
-            tft_draw_text(TFT_WIDTH / 2 - 60, y + 20, "IP: 192.168.1.100", 1, PB_DARK_GREEN);
+        sub_row_state_t *shown = &subMenuShown[i];
+        if (initialDraw || shown->selected != state.selected || shown->status.text != state.status.text ||
+            shown->status.color != state.status.color) {
+            draw_sub_menu_row(row, &state);
+            *shown = state;
         }
     }
 }
@@ -567,150 +1122,174 @@ void draw_wifi_sub_menu(int selectedIndex, bool initialDraw) {
 // =========================================================================
 
 void show_audio_demo(bool running) {
-    static float phase = 0.0;
-    static float last_phase = 0.0;
-    static float last_amplitude = 50.0;
-    static uint64_t last_update = 0;
+    static fx_angle_t phase = 0;
+    static tft_wave_t wave;
+    static int16_t samples[TFT_WIDTH];
     
     const int centerY = 120;
     const int maxAmplitude = 50;
-    const float frequency = 0.05;
+    const int maxPulse = 10;
+    const fx_angle_t frequency = FX_ANGLE_RAD(0.05); // Per column
     const int instructionY = TFT_HEIGHT - 40;
 
     if (!running) {
-        // PREVIEW STATE
-        tft_draw_filled_rect(0, 20, TFT_WIDTH, TFT_HEIGHT - 50, ST77XX_BLACK);
-        tft_draw_text(40, 30, "AUDIO VISUALIZER", 2, PB_GREEN);
+        // PREVIEW STATE, over the pane show_menu_content() cleared
+        tft_draw_text_bg(40, 30, "AUDIO VISUALIZER", 2, PB_GREEN, ST77XX_BLACK);
         tft_draw_h_line(40, 55, TFT_WIDTH - 80, PB_DARK_GREEN);
-        tft_draw_text(30, 70, "Press button to activate visualizer.", 1, PB_GREEN);
+        tft_draw_text_bg(30, 70, "Press button to activate visualizer.", 1, PB_GREEN, ST77XX_BLACK);
         
-        // Draw static preview wave
-        int prevY = centerY;
-        for (int x = 0; x < TFT_WIDTH; x++) {
-            int y = centerY + (int)(sinf(x * 0.05) * 20);
-            if (x > 0) tft_draw_line(x - 1, prevY, x, y, PB_GREEN);
-            prevY = y;
-        }
+        // Draw static preview wave on the cleared pane
+        int waveHalf = maxAmplitude + maxPulse + 1;
+        tft_wave_init(&wave, 0, centerY - waveHalf, TFT_WIDTH, 2 * waveHalf + 1, PB_GREEN, ST77XX_BLACK);
+        tft_wave_mark_clear(&wave);
+        fx_wave_batch(samples, TFT_WIDTH, 0, frequency, 20, centerY);
+        tft_wave_draw(&wave, samples);
         
-        // Reset animation state
-        phase = 0.0;
-        last_phase = 0.0;
-        last_amplitude = maxAmplitude;
+        // Reset animation state; the first frame adds the axis and clears
+        // the wave area (not before: band mode renders the preview at flush)
+        phase = 0;
         
     } else {
         // RUNNING ANIMATION (smooth like Arduino version)
         uint64_t current_time = esp_timer_get_time() / 1000;
         
-        if (current_time - last_update > 30) { // ~33 FPS
-            last_update = current_time;
-            
-            // Vary amplitude for pulsing effect
-            float current_amplitude = maxAmplitude + (sinf(current_time * 0.005) * 10);
-            if (current_amplitude < 10) current_amplitude = 10;
-
-            // 1. ERASE PREVIOUS WAVE
-            int y_prev_erase = centerY + (int)(sinf(0 * frequency + last_phase) * last_amplitude);
-            for (int x = 1; x < TFT_WIDTH; x++) {
-                int y_current_erase = centerY + (int)(sinf(x * frequency + last_phase) * last_amplitude);
-                tft_draw_line(x - 1, y_prev_erase, x, y_current_erase, ST77XX_BLACK);
-                y_prev_erase = y_current_erase;
-            }
-            
-            // 2. Calculate new phase
-            phase += 0.1;
-            if (phase > 2 * M_PI) phase -= 2 * M_PI;
-            
-            last_phase = phase;
-            last_amplitude = current_amplitude;
-            
-            // 3. DRAW NEW WAVE
-            int y_prev_draw = centerY + (int)(sinf(0 * frequency + phase) * current_amplitude);
-            for (int x = 1; x < TFT_WIDTH; x++) {
-                int y_current_draw = centerY + (int)(sinf(x * frequency + phase) * current_amplitude);
-                tft_draw_line(x - 1, y_prev_draw, x, y_current_draw, PB_GREEN);
-                y_prev_draw = y_current_draw;
-            }
+        // Vary amplitude for pulsing effect
+        fx_angle_t pulse = (fx_angle_t)(current_time * FX_ANGLE_RAD(0.005));
+        int current_amplitude = maxAmplitude + FX_MUL_Q15(maxPulse, fx_sin(pulse));
 
-            // 4. Redraw fixed elements
-            tft_draw_h_line(0, centerY, TFT_WIDTH, PB_DARK_GREEN);
+        if (wave.axis_y < 0) {
+            tft_wave_set_axis(&wave, centerY, PB_DARK_GREEN);
+        }
+        if (!wave.drawn) {
+            // Fixed elements are drawn once, the wave area never covers them
             tft_draw_filled_rect(0, instructionY - 5, TFT_WIDTH, 15, ST77XX_BLACK);
-            tft_draw_text(40, instructionY, "Press button to return to menu.", 1, PB_GREEN);
+            tft_draw_text_bg(40, instructionY, "Press button to return to menu.", 1, PB_GREEN, ST77XX_BLACK);
         }
+
+        phase += FX_ANGLE_RAD(0.1); // Wraps at a full turn
+
+        // Only the rows that moved since the last frame are rewritten
+        fx_wave_batch(samples, TFT_WIDTH, phase, frequency, current_amplitude, centerY);
+        tft_wave_draw(&wave, samples);
     }
 }
 
+// One animation step per scheduler slot, drawn by the render task, which also
+// flushes it at the next slot. Slots the render task can't keep up with collapse.
+static void audio_demo_frame(const tft_sched_frame_t *frame, void *arg) {
+    bus_mark_dirty(BUS_RENDER, BUS_DIRTY_FRAME);
+}
+
 // =========================================================================
 //                         P O W E R   S C R E E N
 // =========================================================================
 
 void show_power_screen(void) {
-    tft_draw_filled_rect(0, 20, TFT_WIDTH, TFT_HEIGHT - 50, ST77XX_BLACK);
     draw_shutdown_sequence(false);
-    tft_draw_text(60, TFT_HEIGHT - 60, "Select 'POWER' to halt the system.", 1, PB_DARK_GREEN);
+    tft_draw_text_bg(60, TFT_HEIGHT - 60, "Select 'POWER' to halt the system.", 1, PB_DARK_GREEN, ST77XX_BLACK);
 }
 
+// The preview (is_final false) draws over the cleared content pane; the
+// final sequence takes the whole screen.
 void draw_shutdown_sequence(bool is_final) {
-    tft_fill_screen(ST77XX_BLACK);
-    int centerX = TFT_WIDTH / 2;
-    int centerY = TFT_HEIGHT / 2;
-    
-    // Draw Vault-Tec style symbol (like Arduino version)
-    int symbolRadius = 45;
-    int barLength = 70;
-    int barThickness = 8;
-    int gap = 15;
-    int offset = 10;
-    int textY = centerY + symbolRadius + 30;
-
-    // Outer circles
-    tft_draw_circle(centerX, centerY, symbolRadius, PB_GREEN);
-    tft_draw_circle(centerX, centerY, symbolRadius - 10, PB_GREEN);
-    tft_draw_circle(centerX, centerY, symbolRadius - 20, PB_GREEN);
-    tft_draw_circle(centerX, centerY, symbolRadius - 30, PB_GREEN);
-
-    // Horizontal Bars
-    tft_draw_filled_rect(centerX - barLength - offset, centerY - gap, barLength, barThickness, PB_GREEN);
-    tft_draw_filled_rect(centerX + offset, centerY - gap, barLength, barThickness, PB_GREEN);
-    
-    tft_draw_filled_rect(centerX - barLength - 10 - offset, centerY - gap + barThickness + 5, barLength + 20, barThickness, PB_GREEN);
-    tft_draw_filled_rect(centerX - 10 + offset, centerY - gap + barThickness + 5, barLength + 20, barThickness, PB_GREEN);
+    if (is_final) {
+        tft_fill_screen(ST77XX_BLACK);
+    }
+    int symbolX = TFT_WIDTH / 2 - img_vault_tec.width / 2;
+    int symbolY = TFT_HEIGHT / 2 - img_vault_tec.height / 2;
+    int textY = TFT_HEIGHT / 2 + 75;
+
+    // Vault-Tec symbol (like Arduino version), streamed as one image
+    tft_draw_image(symbolX, symbolY, &img_vault_tec);
 
     if (is_final) {
         // Shutdown sequence text
-        tft_draw_text(20, textY, "SYSTEM SHUTDOWN SEQUENCE INITIATED...", 1, PB_GREEN);
+        tft_draw_text_bg(20, textY, "SYSTEM SHUTDOWN SEQUENCE INITIATED...", 1, PB_GREEN, ST77XX_BLACK);
+        tft_flush();
         vTaskDelay(pdMS_TO_TICKS(300));
-        tft_draw_text(20, textY + 15, "CLOSING ALL MODULES...", 1, PB_GREEN);
+        tft_draw_text_bg(20, textY + 15, "CLOSING ALL MODULES...", 1, PB_GREEN, ST77XX_BLACK);
+        tft_flush();
         vTaskDelay(pdMS_TO_TICKS(300));
-        tft_draw_text(20, textY + 30, "POWERING DOWN DISPLAY.", 1, PB_GREEN);
+        tft_draw_text_bg(20, textY + 30, "POWERING DOWN DISPLAY.", 1, PB_GREEN, ST77XX_BLACK);
+        tft_flush();
         vTaskDelay(pdMS_TO_TICKS(300));
-        tft_draw_text(20, textY + 45, "GOODBYE.", 1, PB_GREEN);
+        tft_draw_text_bg(20, textY + 45, "GOODBYE.", 1, PB_GREEN, ST77XX_BLACK);
+        tft_flush();
         
-        // Fade animation
+        // Fade animation: same runs, dim palette
+        static const uint16_t dim_palette[] = {ST77XX_BLACK, PB_DARK_GREEN};
+        tft_image_t dim_symbol = img_vault_tec;
+        dim_symbol.palette = dim_palette;
+
+        if (tft_get_render_mode() == TFT_MODE_INDEXED) {
+            // Blink by recoloring the symbol's palette entry instead of redrawing
+            tft_fill_screen(ST77XX_BLACK);
+            tft_draw_image(symbolX, symbolY, &img_vault_tec);
+            for (int i = 0; i < 3; i++) {
+                tft_remap_color(PB_GREEN, ST77XX_BLACK);
+                tft_flush();
+                vTaskDelay(pdMS_TO_TICKS(100));
+                tft_remap_color(PB_GREEN, PB_DARK_GREEN);
+                tft_flush();
+                vTaskDelay(pdMS_TO_TICKS(100));
+            }
+            // Keep the dim symbol once the palette is back to normal
+            tft_draw_image(symbolX, symbolY, &dim_symbol);
+            tft_remap_color(PB_GREEN, PB_GREEN);
+            return;
+        }
+
         for (int i = 0; i < 3; i++) {
             tft_fill_screen(ST77XX_BLACK);
+            tft_flush();
             vTaskDelay(pdMS_TO_TICKS(100));
-            // Redraw in dim green
-            tft_draw_circle(centerX, centerY, symbolRadius, PB_DARK_GREEN);
-            tft_draw_circle(centerX, centerY, symbolRadius - 10, PB_DARK_GREEN);
-            tft_draw_circle(centerX, centerY, symbolRadius - 20, PB_DARK_GREEN);
-            tft_draw_circle(centerX, centerY, symbolRadius - 30, PB_DARK_GREEN);
-            tft_draw_filled_rect(centerX - barLength - offset, centerY - gap, barLength, barThickness, PB_DARK_GREEN);
-            tft_draw_filled_rect(centerX + offset, centerY - gap, barLength, barThickness, PB_DARK_GREEN);
-            tft_draw_filled_rect(centerX - barLength - 10 - offset, centerY - gap + barThickness + 5, barLength + 20, barThickness, PB_DARK_GREEN);
-            tft_draw_filled_rect(centerX - 10 + offset, centerY - gap + barThickness + 5, barLength + 20, barThickness, PB_DARK_GREEN);
+            tft_draw_image(symbolX, symbolY, &dim_symbol);
+            tft_flush();
             vTaskDelay(pdMS_TO_TICKS(100));
         }
     }
 }
 
+// =========================================================================
+//                         B E N C H M A R K S
+// =========================================================================
+
+#if CONFIG_TFT_BENCH
+#ifndef CONFIG_TFT_BENCH_ITERATIONS
+#define CONFIG_TFT_BENCH_ITERATIONS 20
+#endif
+
+static void bench_stand_by(void *arg) { draw_please_stand_by(); }
+// Invalidated so every iteration repaints the whole frame
+static void bench_full_menu(void *arg) { tft_frame_invalidate(); draw_full_menu(0); }
+static void bench_audio_frame(void *arg) { show_audio_demo(true); }
+
+void run_display_benchmarks(void) {
+    tft_bench_primitives(CONFIG_TFT_BENCH_ITERATIONS);
+
+    tft_bench_case("screen", "please_stand_by", NULL, bench_stand_by, NULL, CONFIG_TFT_BENCH_ITERATIONS);
+    tft_bench_case("screen", "full_menu", NULL, bench_full_menu, NULL, CONFIG_TFT_BENCH_ITERATIONS);
+
+    draw_full_menu(1);
+    tft_flush();
+    tft_bench_case("screen", "audio_frame", NULL, bench_audio_frame, NULL, CONFIG_TFT_BENCH_ITERATIONS);
+
+    tft_fill_screen(ST77XX_BLACK);
+    tft_flush();
+
+    tft_bench_trig(CONFIG_TFT_BENCH_ITERATIONS);
+}
+#endif
+
 // =========================================================================
 //                         W I F I   T A S K
 // =========================================================================
 
-void wifi_connection_task(void *pvParameter) {
+// Run by the boot task; the station is started later from the menu
+static void wifi_stack_init(void) {
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_t* sta_netif = esp_netif_create_default_wifi_sta();
+    esp_netif_create_default_wifi_sta(); // Lives as long as the app
 
     // Register event handlers
     ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler, NULL));
@@ -718,7 +1297,10 @@ void wifi_connection_task(void *pvParameter) {
 
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+}
 
+// Created once boot_system_task has brought the stack up
+void wifi_connection_task(void *pvParameter) {
     bool wifi_active = false;
 
     while(1) {
@@ -761,9 +1343,9 @@ void wifi_connection_task(void *pvParameter) {
             }
         }
 
-        // Trigger menu redraw
-        int trigger = 1;
-        xQueueSend(encoder_queue, &trigger, 0);
+        // Show the new Wi-Fi status
+        bus_msg_t msg = {.type = BUS_MSG_WIFI, .wifi = {.connected = wifi_status == 2}};
+        bus_post(BUS_LOGIC, &msg);
     }
 }
 
@@ -780,9 +1362,10 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
         ESP_LOGI(TAG, "Got IP: " IPSTR, IP2STR(&event->ip_info.ip));
         wifi_status = 2;
         xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
+        clock_sntp_start();
     }
 
-    // Trigger menu redraw
-    int trigger = 1;
-    xQueueSend(encoder_queue, &trigger, 0);
+    // Show the new Wi-Fi status. Runs on the system event loop: posting never blocks it.
+    bus_msg_t msg = {.type = BUS_MSG_WIFI, .wifi = {.connected = wifi_status == 2}};
+    bus_post(BUS_LOGIC, &msg);
 }
\ No newline at end of file
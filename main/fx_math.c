@@ -0,0 +1,61 @@
+#include "fx_math.h"
+
+// --- Quarter-wave table ---
+// sin over 0..pi/2 in 256 steps, evaluated by the compiler from its Taylor
+// series (error below 1e-7 at pi/2). One extra point past pi/2 lets the
+// interpolation read idx + 1 without a bounds test.
+#define FX_QUARTER_BITS 8
+#define FX_QUARTER_STEP (1.5707963267948966 / (1 << FX_QUARTER_BITS))
+#define FX_FRAC_BITS    (14 - FX_QUARTER_BITS) // Angle bits between table points
+
+#define FX_X2(x) ((x) * (x))
+#define FX_SIN_POLY(x) \
+    ((x) * (1 - FX_X2(x) / 6 * (1 - FX_X2(x) / 20 * (1 - FX_X2(x) / 42 * \
+    (1 - FX_X2(x) / 72 * (1 - FX_X2(x) / 110 * (1 - FX_X2(x) / 156)))))))
+
+#define FX_ENTRY(i)  (q15_t)(FX_SIN_POLY((i) * FX_QUARTER_STEP) * FX_Q15_ONE + 0.5),
+#define FX_ENTRY2(i)   FX_ENTRY(i)     FX_ENTRY((i) + 1)
+#define FX_ENTRY4(i)   FX_ENTRY2(i)    FX_ENTRY2((i) + 2)
+#define FX_ENTRY8(i)   FX_ENTRY4(i)    FX_ENTRY4((i) + 4)
+#define FX_ENTRY16(i)  FX_ENTRY8(i)    FX_ENTRY8((i) + 8)
+#define FX_ENTRY32(i)  FX_ENTRY16(i)   FX_ENTRY16((i) + 16)
+#define FX_ENTRY64(i)  FX_ENTRY32(i)   FX_ENTRY32((i) + 32)
+#define FX_ENTRY128(i) FX_ENTRY64(i)   FX_ENTRY64((i) + 64)
+#define FX_ENTRY256(i) FX_ENTRY128(i)  FX_ENTRY128((i) + 128)
+
+static const q15_t sin_quarter[(1 << FX_QUARTER_BITS) + 2] = {
+    FX_ENTRY256(0)
+    FX_ENTRY2(256)
+};
+
+// --- Evaluation ---
+// Branch-free apart from selects, so batch loops stay simple counted loops
+static inline int fx_sin_eval(uint32_t a) {
+    uint32_t t = a & 0x3FFF;
+    uint32_t u = (a & 0x4000) ? 0x4000 - t : t; // Mirror the 2nd and 4th quadrants
+    uint32_t i = u >> FX_FRAC_BITS;
+    int32_t f = u & ((1 << FX_FRAC_BITS) - 1);
+    int32_t y0 = sin_quarter[i];
+    int32_t v = y0 + (((sin_quarter[i + 1] - y0) * f + (1 << (FX_FRAC_BITS - 1))) >> FX_FRAC_BITS);
+    return (a & 0x8000) ? -v : v;
+}
+
+q15_t fx_sin(fx_angle_t a) {
+    return fx_sin_eval(a);
+}
+
+q15_t fx_cos(fx_angle_t a) {
+    return fx_sin_eval((fx_angle_t)(a + 0x4000));
+}
+
+void fx_sin_batch(q15_t *out, int n, fx_angle_t start, fx_angle_t step) {
+    for (int i = 0; i < n; i++) {
+        out[i] = fx_sin_eval((fx_angle_t)(start + (uint32_t)i * step));
+    }
+}
+
+void fx_wave_batch(int16_t *out, int n, fx_angle_t start, fx_angle_t step, int amplitude, int offset) {
+    for (int i = 0; i < n; i++) {
+        out[i] = offset + FX_MUL_Q15(amplitude, fx_sin_eval((fx_angle_t)(start + (uint32_t)i * step)));
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef FX_MATH_H
+#define FX_MATH_H
+
+#include <stdint.h>
+
+// Fixed-point trig for animations. Angles are binary: 65536 units make a full
+// turn, so they wrap for free in a uint16_t and phase accumulators need no
+// 2*pi test. Sine and cosine come from a quarter-wave Q15 table built by the
+// compiler, with linear interpolation between its 257 points; the result stays
+// within about 1 LSB (3e-5) of the exact value.
+
+typedef uint16_t fx_angle_t; // 65536 = one turn
+typedef int16_t q15_t;       // -32767..32767 = -1.0..1.0
+
+#define FX_Q15_ONE 32767
+
+// Constant angles; also fine for integer variables (FX_ANGLE_DEG)
+#define FX_ANGLE_DEG(d) ((fx_angle_t)(((int32_t)(d) * 65536 + 180) / 360))
+#define FX_ANGLE_RAD(r) ((fx_angle_t)(int32_t)((r) * 10430.378350470453 + 0.5))
+
+// v * q rounded to the nearest integer
+#define FX_MUL_Q15(v, q) ((int)(((int32_t)(v) * (q) + 0x4000) >> 15))
+
+q15_t fx_sin(fx_angle_t a);
+q15_t fx_cos(fx_angle_t a);
+
+// out[i] = sin(start + i * step), n values
+void fx_sin_batch(q15_t *out, int n, fx_angle_t start, fx_angle_t step);
+// out[i] = offset + amplitude * sin(start + i * step), rounded; a waveform's
+// sample rows in one table walk
+void fx_wave_batch(int16_t *out, int n, fx_angle_t start, fx_angle_t step, int amplitude, int offset);
+
+#endif
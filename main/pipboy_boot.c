@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include "pipboy_boot.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "BOOT";
+
+static const char *const phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_NVS] = "NVS",
+    [BOOT_PHASE_CLOCK] = "CLOCK",
+    [BOOT_PHASE_NETWORK] = "NETWORK",
+    [BOOT_PHASE_PANEL] = "PANEL",
+    [BOOT_PHASE_RENDER] = "RENDER",
+    [BOOT_PHASE_SPLASH] = "SPLASH",
+    [BOOT_PHASE_INTERACTIVE] = "INTERACTIVE",
+};
+
+// Written once each, by the task running the phase
+static int64_t begin_us[BOOT_PHASE_COUNT];
+static int64_t end_us[BOOT_PHASE_COUNT];
+static EventGroupHandle_t done_bits; // BOOT_BIT() of every phase that ended
+
+void boot_init(void) {
+    done_bits = xEventGroupCreate();
+    if (!done_bits) {
+        ESP_LOGE(TAG, "Failed to create the boot event group");
+        abort();
+    }
+}
+
+void boot_phase_begin(boot_phase_t phase) {
+    begin_us[phase] = esp_timer_get_time();
+}
+
+void boot_phase_end(boot_phase_t phase) {
+    end_us[phase] = esp_timer_get_time();
+    xEventGroupSetBits(done_bits, BOOT_BIT(phase));
+}
+
+bool boot_wait(uint32_t mask, TickType_t timeout) {
+    EventBits_t bits = xEventGroupWaitBits(done_bits, mask, pdFALSE, pdTRUE, timeout);
+    return (bits & mask) == mask;
+}
+
+boot_phase_t boot_pending(uint32_t mask) {
+    uint32_t pending = mask & ~(uint32_t)xEventGroupGetBits(done_bits);
+    for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        if (pending & BOOT_BIT(phase)) {
+            return phase;
+        }
+    }
+    return BOOT_PHASE_COUNT;
+}
+
+int64_t boot_phase_end_us(boot_phase_t phase) {
+    return (xEventGroupGetBits(done_bits) & BOOT_BIT(phase)) ? end_us[phase] : 0;
+}
+
+const char *boot_phase_name(boot_phase_t phase) {
+    return phase < BOOT_PHASE_COUNT ? phase_names[phase] : "?";
+}
+
+void boot_log_timeline(void) {
+    EventBits_t done = xEventGroupGetBits(done_bits);
+    for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        if (!(done & BOOT_BIT(phase))) {
+            ESP_LOGW(TAG, "%-11s not finished", phase_names[phase]);
+            continue;
+        }
+        ESP_LOGI(TAG, "%-11s %5lld -> %5lld ms (%lld ms)", phase_names[phase],
+                 (long long)(begin_us[phase] / 1000), (long long)(end_us[phase] / 1000),
+                 (long long)((end_us[phase] - begin_us[phase]) / 1000));
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef PIPBOY_BOOT_H
+#define PIPBOY_BOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+
+// Boot timeline. Independent phases run at the same time on different tasks;
+// each one records when it began and ended (esp_timer time, i.e. since the
+// app started), and whatever depends on a phase waits for it to end rather
+// than for a fixed delay. The end of BOOT_PHASE_INTERACTIVE is the time to
+// the first interactive frame.
+
+typedef enum {
+    BOOT_PHASE_NVS,
+    BOOT_PHASE_CLOCK,
+    BOOT_PHASE_NETWORK,     // netif, event loop and Wi-Fi driver
+    BOOT_PHASE_PANEL,       // Reset and init command delays, first clear
+    BOOT_PHASE_RENDER,      // Menu layout, render mode, frame scheduler
+    BOOT_PHASE_SPLASH,      // Until the splash is on the panel
+    BOOT_PHASE_INTERACTIVE, // Until the menu is on the panel, input live
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+#define BOOT_BIT(phase) (1u << (phase))
+
+// Call before any phase begins
+void boot_init(void);
+// Safe from any task; each phase is run by one task only
+void boot_phase_begin(boot_phase_t phase);
+void boot_phase_end(boot_phase_t phase);
+
+// Blocks until every phase in mask (BOOT_BIT()s) has ended; false on timeout
+bool boot_wait(uint32_t mask, TickType_t timeout);
+// First phase in mask that hasn't ended, or BOOT_PHASE_COUNT
+boot_phase_t boot_pending(uint32_t mask);
+// 0 while the phase hasn't ended
+int64_t boot_phase_end_us(boot_phase_t phase);
+const char *boot_phase_name(boot_phase_t phase);
+
+// One line per phase: start, end and duration in ms
+void boot_log_timeline(void);
+
+#endif // PIPBOY_BOOT_H
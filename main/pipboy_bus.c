@@ -0,0 +1,142 @@
+#include "pipboy_bus.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+
+static const char *TAG = "BUS";
+
+typedef struct {
+    TaskHandle_t task;
+    bus_msg_t ring[BUS_QUEUE_DEPTH];
+    uint8_t head;
+    uint8_t len;
+    uint32_t early_bits; // Dirty bits marked before the consumer registered
+    bus_stats_t stats;
+} bus_consumer_state_t;
+
+static bus_consumer_state_t consumers[BUS_CONSUMER_COUNT];
+static portMUX_TYPE bus_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const consumer_names[BUS_CONSUMER_COUNT] = {"logic", "render"};
+
+void bus_register(bus_consumer_t consumer) {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+    portENTER_CRITICAL(&bus_lock);
+    consumers[consumer].task = task;
+    uint32_t pending = consumers[consumer].early_bits;
+    if (consumers[consumer].len > 0) {
+        pending |= BUS_MSG_PENDING;
+    }
+    consumers[consumer].early_bits = 0;
+    portEXIT_CRITICAL(&bus_lock);
+
+    // Messages posted and bits marked before the consumer existed
+    if (pending) {
+        xTaskNotify(task, pending, eSetBits);
+    }
+}
+
+// Call with bus_lock held
+static bool IRAM_ATTR bus_push(bus_consumer_state_t *c, const bus_msg_t *msg) {
+    if (c->len == BUS_QUEUE_DEPTH) {
+        c->stats.dropped++;
+        return false;
+    }
+    c->ring[(c->head + c->len) % BUS_QUEUE_DEPTH] = *msg;
+    c->len++;
+    c->stats.posted++;
+    return true;
+}
+
+bool bus_post(bus_consumer_t consumer, const bus_msg_t *msg) {
+    bus_consumer_state_t *c = &consumers[consumer];
+
+    portENTER_CRITICAL(&bus_lock);
+    bool ok = bus_push(c, msg);
+    TaskHandle_t task = c->task;
+    portEXIT_CRITICAL(&bus_lock);
+
+    if (ok && task) {
+        xTaskNotify(task, BUS_MSG_PENDING, eSetBits);
+    }
+    return ok;
+}
+
+bool IRAM_ATTR bus_post_from_isr(bus_consumer_t consumer, const bus_msg_t *msg, BaseType_t *woken) {
+    bus_consumer_state_t *c = &consumers[consumer];
+
+    portENTER_CRITICAL_ISR(&bus_lock);
+    bool ok = bus_push(c, msg);
+    TaskHandle_t task = c->task;
+    portEXIT_CRITICAL_ISR(&bus_lock);
+
+    if (ok && task) {
+        xTaskNotifyFromISR(task, BUS_MSG_PENDING, eSetBits, woken);
+    }
+    return ok;
+}
+
+void bus_mark_dirty(bus_consumer_t consumer, uint32_t bits) {
+    bus_consumer_state_t *c = &consumers[consumer];
+
+    portENTER_CRITICAL(&bus_lock);
+    c->stats.marks++;
+    TaskHandle_t task = c->task;
+    if (!task) {
+        c->early_bits |= bits;
+    }
+    portEXIT_CRITICAL(&bus_lock);
+
+    // eSetBits ORs into the pending value, so repeated marks merge
+    if (task) {
+        xTaskNotify(task, bits, eSetBits);
+    }
+}
+
+uint32_t bus_wait(bus_consumer_t consumer, TickType_t timeout) {
+    bus_consumer_state_t *c = &consumers[consumer];
+    uint32_t bits = 0;
+
+    xTaskNotifyWait(0, UINT32_MAX, &bits, timeout);
+
+    portENTER_CRITICAL(&bus_lock);
+    if (c->len > 0) {
+        bits |= BUS_MSG_PENDING; // Left over from a bounded bus_receive() loop
+    }
+    if (bits) {
+        c->stats.wakeups++;
+    }
+    portEXIT_CRITICAL(&bus_lock);
+    return bits;
+}
+
+bool bus_receive(bus_consumer_t consumer, bus_msg_t *msg) {
+    bus_consumer_state_t *c = &consumers[consumer];
+    bool found = false;
+
+    portENTER_CRITICAL(&bus_lock);
+    if (c->len > 0) {
+        *msg = c->ring[c->head];
+        c->head = (c->head + 1) % BUS_QUEUE_DEPTH;
+        c->len--;
+        found = true;
+    }
+    portEXIT_CRITICAL(&bus_lock);
+    return found;
+}
+
+void bus_get_stats(bus_consumer_t consumer, bus_stats_t *out) {
+    portENTER_CRITICAL(&bus_lock);
+    *out = consumers[consumer].stats;
+    portEXIT_CRITICAL(&bus_lock);
+}
+
+void bus_log_stats(void) {
+    for (int i = 0; i < BUS_CONSUMER_COUNT; i++) {
+        bus_stats_t s;
+        bus_get_stats((bus_consumer_t)i, &s);
+        ESP_LOGI(TAG, "%s: %lu posted, %lu dropped, %lu dirty marks in %lu wakeups",
+                 consumer_names[i], (unsigned long)s.posted, (unsigned long)s.dropped,
+                 (unsigned long)s.marks, (unsigned long)s.wakeups);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef PIPBOY_BUS_H
+#define PIPBOY_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Message bus between the input, logic, WiFi and render tasks. Every
+// consumer has its own small ring of tagged messages and is woken through
+// its task notification. Redraw requests are not messages but dirty bits
+// ORed into the render task's notification value, so any number of them
+// between two frames costs one frame. Posting never blocks: a message that
+// finds its ring full is dropped and counted.
+
+// --- Encoder Event Data Structure ---
+typedef enum {
+    ENC_DIR_NONE,
+    ENC_DIR_CW,
+    ENC_DIR_CCW
+} encoder_direction_t;
+
+typedef struct {
+    encoder_direction_t direction;
+    bool button_press;
+} encoder_event_t;
+
+// --- Messages ---
+typedef enum {
+    BUS_MSG_INPUT,  // Rotation or button press (msg.input)
+    BUS_MSG_WIFI,   // Station connected / disconnected (msg.wifi)
+} bus_msg_type_t;
+
+typedef struct {
+    bus_msg_type_t type;
+    union {
+        encoder_event_t input;
+        struct {
+            bool connected;
+        } wifi;
+    };
+} bus_msg_t;
+
+typedef enum {
+    BUS_LOGIC,   // Encoder task: input and WiFi messages
+    BUS_RENDER,  // Render task: dirty bits only
+    BUS_CONSUMER_COUNT
+} bus_consumer_t;
+
+#define BUS_QUEUE_DEPTH 16
+
+// --- Dirty Bits ---
+#define BUS_DIRTY_MENU      (1u << 0) // Menu or sub-menu state changed
+#define BUS_DIRTY_STATUS    (1u << 1) // Status bar (clock, WiFi)
+#define BUS_DIRTY_DEMO      (1u << 2) // Demo entered or left
+#define BUS_DIRTY_HALT      (1u << 3) // Shutdown requested
+#define BUS_DIRTY_BOOT      (1u << 4) // Splash shown or dismissed
+#define BUS_DIRTY_POWER     (1u << 5) // Panel power state requested
+#define BUS_DIRTY_FRAME     (1u << 6) // Frame scheduler slot (animation)
+#define BUS_DIRTY_CLOCK     (1u << 7) // Hourly clock save due (logic side)
+#define BUS_MSG_PENDING     (1u << 31) // Set by the bus: messages are waiting
+
+typedef struct {
+    uint32_t posted;
+    uint32_t dropped;   // Ring full
+    uint32_t marks;     // bus_mark_dirty() calls
+    uint32_t wakeups;   // bus_wait() returns with something to do
+} bus_stats_t;
+
+// Called by each consumer task before its first bus_wait(). Messages and
+// dirty bits sent before then are delivered at the first bus_wait().
+void bus_register(bus_consumer_t consumer);
+
+// Never block; false when the message was dropped
+bool bus_post(bus_consumer_t consumer, const bus_msg_t *msg);
+bool bus_post_from_isr(bus_consumer_t consumer, const bus_msg_t *msg, BaseType_t *woken);
+// Coalescing: all marks between two bus_wait() calls make one wakeup
+void bus_mark_dirty(bus_consumer_t consumer, uint32_t bits);
+
+// Consumer side. Returns the dirty bits (plus BUS_MSG_PENDING) collected
+// since the last call, 0 on timeout; messages are then read with bus_receive().
+uint32_t bus_wait(bus_consumer_t consumer, TickType_t timeout);
+bool bus_receive(bus_consumer_t consumer, bus_msg_t *msg);
+
+void bus_get_stats(bus_consumer_t consumer, bus_stats_t *out);
+void bus_log_stats(void);
+
+#endif // PIPBOY_BUS_H
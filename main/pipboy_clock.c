@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "pipboy_clock.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_sntp.h"
+#include "nvs.h"
+
+static const char *TAG = "CLOCK";
+
+// --- Configuration ---
+#ifndef CONFIG_PIPBOY_TIMEZONE
+#define CONFIG_PIPBOY_TIMEZONE "UTC0"
+#endif
+
+#ifndef CONFIG_PIPBOY_SNTP_SERVER
+#define CONFIG_PIPBOY_SNTP_SERVER "pool.ntp.org"
+#endif
+
+#define CLOCK_VALID_EPOCH   1704067200 // 2024-01-01: anything earlier was never set
+#define CLOCK_TICK_SLACK_US 2000       // Wake just past the boundary, not before it
+#define CLOCK_NVS_NAMESPACE "clock"
+#define CLOCK_NVS_KEY       "epoch"
+
+static clock_change_cb_t change_cb;
+static esp_timer_handle_t minute_timer;
+
+static bool clock_is_set(const struct timeval *tv) {
+    return tv->tv_sec >= CLOCK_VALID_EPOCH;
+}
+
+// --- Persistence ---
+void clock_save(void) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if (!clock_is_set(&now)) {
+        return;
+    }
+
+    nvs_handle_t nvs;
+    if (nvs_open(CLOCK_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        ESP_LOGW(TAG, "Can't open NVS, time not saved");
+        return;
+    }
+    if (nvs_set_i64(nvs, CLOCK_NVS_KEY, now.tv_sec) == ESP_OK) {
+        nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+}
+
+static bool clock_restore(void) {
+    nvs_handle_t nvs;
+    int64_t saved = 0;
+    if (nvs_open(CLOCK_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return false;
+    }
+    esp_err_t err = nvs_get_i64(nvs, CLOCK_NVS_KEY, &saved);
+    nvs_close(nvs);
+
+    if (err != ESP_OK || saved < CLOCK_VALID_EPOCH) {
+        return false;
+    }
+    settimeofday(&(struct timeval){.tv_sec = (time_t)saved}, NULL);
+    return true;
+}
+
+// --- Minute Ticks ---
+// One-shot timer re-armed for each minute boundary, so it follows time
+// changes instead of drifting against them
+static void clock_arm(void) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    uint64_t us = (60 - now.tv_sec % 60) * 1000000ULL - now.tv_usec + CLOCK_TICK_SLACK_US;
+
+    esp_timer_stop(minute_timer); // Not running is fine
+    esp_timer_start_once(minute_timer, us);
+}
+
+static void clock_minute_tick(void *arg) {
+    struct tm local;
+    bool save_due = clock_get_local(&local) && local.tm_min == 0;
+    clock_arm();
+    if (change_cb) {
+        change_cb(save_due);
+    }
+}
+
+static void clock_sntp_synced(struct timeval *tv) {
+    ESP_LOGI(TAG, "Time set by SNTP");
+    clock_save();
+    clock_arm();
+    if (change_cb) {
+        change_cb(false);
+    }
+}
+
+void clock_init(clock_change_cb_t on_change) {
+    change_cb = on_change;
+    setenv("TZ", CONFIG_PIPBOY_TIMEZONE, 1);
+    tzset();
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if (clock_is_set(&now)) {
+        ESP_LOGI(TAG, "Time kept by the RTC");
+    } else if (clock_restore()) {
+        ESP_LOGI(TAG, "Time restored from NVS until SNTP sets it");
+    } else {
+        ESP_LOGI(TAG, "Time unknown until SNTP sets it");
+    }
+
+    esp_timer_create_args_t args = {
+        .callback = clock_minute_tick,
+        .name = "clock",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&args, &minute_timer));
+    clock_arm();
+}
+
+void clock_sntp_start(void) {
+    if (esp_sntp_enabled()) {
+        return;
+    }
+    esp_sntp_setoperatingmode(ESP_SNTP_OPMODE_POLL);
+    esp_sntp_setservername(0, CONFIG_PIPBOY_SNTP_SERVER);
+    sntp_set_time_sync_notification_cb(clock_sntp_synced);
+    esp_sntp_init();
+}
+
+// --- Reading ---
+bool clock_get_local(struct tm *out) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    if (!clock_is_set(&now)) {
+        return false;
+    }
+    time_t t = now.tv_sec;
+    localtime_r(&t, out);
+    return true;
+}
+
+void clock_format_hhmm(char *out) {
+    struct tm local;
+    if (clock_get_local(&local)) {
+        snprintf(out, 6, "%02u:%02u", (unsigned)local.tm_hour % 24, (unsigned)local.tm_min % 60);
+    } else {
+        snprintf(out, 6, "--:--");
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef PIPBOY_CLOCK_H
+#define PIPBOY_CLOCK_H
+
+#include <stdbool.h>
+#include <time.h>
+
+// Wall clock for the status bar. The system time (kept by the RTC across
+// resets) is set by SNTP once online; after a power loss, the last time
+// saved to NVS stands in until then. The change callback runs on every
+// minute boundary and whenever the time is set, so nothing needs to poll it.
+
+// Runs on the esp_timer or SNTP task: keep it short. save_due is set on the
+// hour; the hourly save is left to the owner, who calls clock_save() from a
+// task of its own instead of blocking the timer task on a flash write.
+typedef void (*clock_change_cb_t)(bool save_due);
+
+// Call after nvs_flash_init()
+void clock_init(clock_change_cb_t on_change);
+// Once the station has an IP; later calls do nothing
+void clock_sntp_start(void);
+// Persist the current time (also done on every SNTP sync). Writes flash:
+// not from timer callbacks.
+void clock_save(void);
+
+// False while the time is unknown
+bool clock_get_local(struct tm *out);
+// "HH:MM", or "--:--" while the time is unknown; out holds 6 chars
+void clock_format_hhmm(char *out);
+
+#endif // PIPBOY_CLOCK_H
@@ -7,6 +7,7 @@
 #include "freertos/queue.h"
 #include "freertos/event_groups.h"
 #include "freertos/semphr.h"
+#include "pipboy_bus.h"
 
 // --- Global State Management ---
 typedef struct {
@@ -18,23 +19,9 @@ typedef struct {
     bool isSystemHalted;
 } menu_state_t;
 
-// --- Encoder Event Definitions ---
-typedef enum {
-    ENC_DIR_NONE,
-    ENC_DIR_CW,
-    ENC_DIR_CCW
-} encoder_direction_t;
-
-typedef struct {
-    encoder_direction_t direction;
-    bool button_press;
-} encoder_event_t;
-
 // --- External Global Variables ---
 extern menu_state_t g_state;
 extern SemaphoreHandle_t tft_mutex;
-extern QueueHandle_t encoder_queue;
-extern QueueHandle_t menu_update_queue;
 extern EventGroupHandle_t wifi_event_group;
 extern const int WIFI_CONNECTED_BIT;
 
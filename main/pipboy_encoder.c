@@ -5,6 +5,8 @@
 #include "driver/gpio.h"
 #include "esp_log.h"
 #include "pipboy_state.h"
+#include "pipboy_menu.h"
+#include "pipboy_clock.h"
 #include "esp_random.h"
 
 
@@ -13,14 +15,18 @@ static const char *TAG = "ENC_TASK";
 // --- Encoder ISR (Handles button press) ---
 static void IRAM_ATTR gpio_isr_handler(void* arg) {
     uint32_t gpio_num = (uint32_t) arg;
-    encoder_event_t event = {ENC_DIR_NONE, false};
+    BaseType_t woken = pdFALSE;
 
     if (gpio_num == PIN_ENCODER_SW) {
         // Simple button press detection (debounce/timing handled in task)
-        event.button_press = true;
-        xQueueSendFromISR(g_encoder_queue, &event, NULL);
+        bus_msg_t msg = {.type = BUS_MSG_INPUT, .input = {ENC_DIR_NONE, true}};
+        bus_post_from_isr(BUS_LOGIC, &msg, &woken);
     } 
     // Rotation logic would typically use PCNT or a high-frequency timer
+
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
 }
 
 // TASK 1: Handles Rotary Encoder Input and Menu Logic
@@ -38,15 +44,8 @@ void encoder_task(void *pvParameter) {
     
     // Simple state simulation for rotation (replace with PCNT logic)
     while (1) {
-        encoder_event_t event;
-        
-        // --- Process Button Events from Queue (or rotational events) ---
-        if (xQueueReceive(g_encoder_queue, &event, 0) == pdTRUE) {
-            if (event.button_press || event.direction != ENC_DIR_NONE) {
-                // Send event to the Menu Logic Task for state change processing
-                xQueueSend(g_menu_update_queue, &event, portMAX_DELAY);
-            }
-        }
+        // Button presses go from the ISR straight to the Menu Logic Task
+        bus_msg_t msg = {.type = BUS_MSG_INPUT, .input = {ENC_DIR_NONE, false}};
         
         // --- Simulate Rotation (replace with actual PCNT read) ---
         if (g_state.isDemoActive || g_state.isSystemHalted) {
@@ -55,12 +54,13 @@ void encoder_task(void *pvParameter) {
         }
 
         // Fictional rotation reading (simulate rotation every 5 seconds)
+        // A full bus drops the step (counted) rather than stalling the input
         if (esp_random() % 1000 < 1) { 
-            event.direction = ENC_DIR_CW;
-            xQueueSend(g_encoder_queue, &event, portMAX_DELAY);
+            msg.input.direction = ENC_DIR_CW;
+            bus_post(BUS_LOGIC, &msg);
         } else if (esp_random() % 1000 < 1) {
-            event.direction = ENC_DIR_CCW;
-            xQueueSend(g_encoder_queue, &event, portMAX_DELAY);
+            msg.input.direction = ENC_DIR_CCW;
+            bus_post(BUS_LOGIC, &msg);
         }
 
         vTaskDelay(pdMS_TO_TICKS(10)); 
@@ -68,77 +68,133 @@ void encoder_task(void *pvParameter) {
 }
 
 
+// --- Menu Actions ---
+// Ids from the menu tree (pipboy_menu.c) mapped to this front end's state.
+// Each one leaves the render dirty bits it causes in action_dirty.
+static uint32_t action_dirty;
+
+static void action_open(menu_id_t node) {
+    g_state.isDemoActive = true;
+    g_state.isSubMenuActive = true;
+    g_state.currentSubMenuIndex = 0;
+    action_dirty = BUS_DIRTY_MENU;
+}
+
+static void action_back(menu_id_t node) {
+    g_state.isSubMenuActive = false;
+    g_state.isDemoActive = false;
+    action_dirty = BUS_DIRTY_MENU;
+}
+
+static void action_audio_demo(menu_id_t node) {
+    g_state.isDemoActive = true;
+    action_dirty = BUS_DIRTY_DEMO;
+}
+
+static void action_halt(menu_id_t node) {
+    g_state.isSystemHalted = true;
+    ESP_LOGW(TAG, "SYSTEM HALT INITIATED");
+    action_dirty = BUS_DIRTY_HALT;
+}
+
+static void action_wifi_toggle(menu_id_t node) {
+    xEventGroupSetBits(g_wifi_event_group, WIFI_TOGGLE_BIT); // Command to WiFi Task
+    action_dirty = BUS_DIRTY_MENU;
+}
+
+static void action_broker_toggle(menu_id_t node) {
+    g_state.isBrokerConnected = !g_state.isBrokerConnected;
+    ESP_LOGI(TAG, "Broker %d", g_state.isBrokerConnected);
+    action_dirty = BUS_DIRTY_MENU | BUS_DIRTY_STATUS;
+}
+
+// No log view here: MENU_ACTION_SYSTEM_LOG does nothing
+static const menu_action_fn menu_actions[MENU_ACTION_COUNT] = {
+    [MENU_ACTION_OPEN] = action_open,
+    [MENU_ACTION_BACK] = action_back,
+    [MENU_ACTION_AUDIO_DEMO] = action_audio_demo,
+    [MENU_ACTION_HALT] = action_halt,
+    [MENU_ACTION_WIFI_TOGGLE] = action_wifi_toggle,
+    [MENU_ACTION_BROKER_TOGGLE] = action_broker_toggle,
+};
+
+// Handles one input message; returns the render dirty bits it causes
+static uint32_t menu_handle_input(const encoder_event_t *enc_event) {
+    if (g_state.isSystemHalted) return 0;
+
+    menu_id_t tab = menu_child(MENU_ROOT, g_state.currentMenuIndex);
+
+    // 1. Handle Rotation
+    if (enc_event->direction != ENC_DIR_NONE) {
+        int step = (enc_event->direction == ENC_DIR_CW) ? 1 : -1;
+
+        if (g_state.isSubMenuActive) {
+            // Sub-Menu Navigation (Vertical)
+            g_state.currentSubMenuIndex = menu_wrap(tab, g_state.currentSubMenuIndex, step);
+            ESP_LOGI(TAG, "Sub-Menu Nav: %d", g_state.currentSubMenuIndex);
+        } else if (!g_state.isDemoActive) {
+            // Main Menu Navigation (Horizontal)
+            g_state.currentMenuIndex = menu_wrap(MENU_ROOT, g_state.currentMenuIndex, step);
+            tab = menu_child(MENU_ROOT, g_state.currentMenuIndex);
+            ESP_LOGI(TAG, "Main Menu Nav: %d (%s)", g_state.currentMenuIndex, menu_node(tab)->label);
+        }
+        return BUS_DIRTY_MENU;
+    }
+    
+    // 2. Handle Button Press
+    if (!enc_event->button_press) return 0;
+
+    if (!g_state.isSubMenuActive && g_state.isDemoActive) {
+         // Exit general demo (Audio)
+        g_state.isDemoActive = false;
+        ESP_LOGI(TAG, "Action: Exit Demo Mode");
+        return BUS_DIRTY_DEMO | BUS_DIRTY_MENU;
+    }
+
+    // Sub-menu row, or the selected tab
+    action_dirty = 0;
+    menu_activate(menu_actions, g_state.isSubMenuActive ? menu_child(tab, g_state.currentSubMenuIndex) : tab);
+    return action_dirty;
+}
+
 // TASK 2: Handles Menu State Changes based on Encoder Input (Logic Decoupled from Input)
 void menu_logic_task(void *pvParameter) {
     ESP_LOGI(TAG, "Menu Logic Task started.");
+    bus_register(BUS_LOGIC);
+    uint32_t last_dropped = 0;
     
     while (1) {
-        encoder_event_t enc_event;
-
-        // Process combined rotation/button events from the Encoder Task
-        if (xQueueReceive(g_menu_update_queue, &enc_event, portMAX_DELAY) == pdTRUE) {
-            
-            if (g_state.isSystemHalted) continue;
-
-            // 1. Handle Rotation
-            if (enc_event.direction != ENC_DIR_NONE) {
-                int step = (enc_event.direction == ENC_DIR_CW) ? 1 : -1;
-
-                if (g_state.isSubMenuActive && g_state.currentMenuIndex == 0) {
-                    // Sub-Menu Navigation (Vertical)
-                    g_state.currentSubMenuIndex = (g_state.currentSubMenuIndex + step) % WIFI_SUB_MENU_SIZE;
-                    if (g_state.currentSubMenuIndex < 0) g_state.currentSubMenuIndex = WIFI_SUB_MENU_SIZE - 1;
-                    ESP_LOGI(TAG, "Sub-Menu Nav: %d", g_state.currentSubMenuIndex);
-                    // No need to send to update queue, just set the flag below
-                } else if (!g_state.isDemoActive) {
-                    // Main Menu Navigation (Horizontal)
-                    g_state.currentMenuIndex = (g_state.currentMenuIndex + step) % MENU_SIZE;
-                    if (g_state.currentMenuIndex < 0) g_state.currentMenuIndex = MENU_SIZE - 1;
-                    ESP_LOGI(TAG, "Main Menu Nav: %d (%s)", g_state.currentMenuIndex, MENU_ITEMS[g_state.currentMenuIndex]);
-                    // No need to send to update queue, just set the flag below
-                }
-            }
-            
-            // 2. Handle Button Press
-            if (enc_event.button_press) {
-                if (g_state.isSubMenuActive && g_state.currentMenuIndex == 0) {
-                    // Action in WiFi Sub-Menu
-                    if (g_state.currentSubMenuIndex == 0) {
-                        ESP_LOGI(TAG, "Action: Toggle WiFi Triggered");
-                        xEventGroupSetBits(g_wifi_event_group, WIFI_TOGGLE_BIT); // Command to WiFi Task
-                    } else if (g_state.currentSubMenuIndex == 1) {
-                        g_state.isBrokerConnected = !g_state.isBrokerConnected;
-                        ESP_LOGI(TAG, "Action: Toggle Broker to %d", g_state.isBrokerConnected);
-                    } else if (g_state.currentSubMenuIndex == 2) {
-                        g_state.isSubMenuActive = false;
-                        g_state.isDemoActive = false;
-                        ESP_LOGI(TAG, "Action: Back to Main Menu");
-                    }
-                } else if (g_state.isDemoActive) {
-                     // Exit general demo (Audio or Sub-Menu)
-                    g_state.isDemoActive = false;
-                    g_state.isSubMenuActive = false;
-                    ESP_LOGI(TAG, "Action: Exit Demo Mode");
-                } else {
-                    // Main Menu Action (Enter Sub-Menu/Demo)
-                    if (g_state.currentMenuIndex == 0) { // WIFI
-                        g_state.isDemoActive = true;
-                        g_state.isSubMenuActive = true;
-                        g_state.currentSubMenuIndex = 0;
-                        ESP_LOGI(TAG, "Action: Enter WIFI Sub-Menu");
-                    } else if (g_state.currentMenuIndex == 1) { // AUDIO
-                        g_state.isDemoActive = true;
-                        ESP_LOGI(TAG, "Action: Enter Audio Demo");
-                    } else if (g_state.currentMenuIndex == 2) { // POWER
-                        g_state.isSystemHalted = true;
-                        ESP_LOGW(TAG, "SYSTEM HALT INITIATED");
-                    }
-                }
+        if (bus_wait(BUS_LOGIC, portMAX_DELAY) & BUS_DIRTY_CLOCK) {
+            clock_save(); // Hourly, off the esp_timer task
+        }
+
+        // Drain everything that arrived, then ask for one redraw: a burst of
+        // rotations becomes a single frame showing the final selection
+        uint32_t dirty = 0;
+        bus_msg_t msg;
+        while (bus_receive(BUS_LOGIC, &msg)) {
+            switch (msg.type) {
+                case BUS_MSG_INPUT:
+                    dirty |= menu_handle_input(&msg.input);
+                    break;
+                case BUS_MSG_WIFI:
+                    ESP_LOGI(TAG, "WiFi %s", msg.wifi.connected ? "connected" : "disconnected");
+                    dirty |= BUS_DIRTY_STATUS | BUS_DIRTY_MENU;
+                    break;
             }
-            
-            // Trigger a redraw after ANY state change (rotation or button)
-            int redraw_flag = 1;
-            xQueueSend(g_menu_update_queue, &redraw_flag, portMAX_DELAY);
+        }
+
+        if (dirty) {
+            bus_mark_dirty(BUS_RENDER, dirty);
+        }
+
+        // Producers never block, so a full ring shows up here instead
+        bus_stats_t stats;
+        bus_get_stats(BUS_LOGIC, &stats);
+        if (stats.dropped != last_dropped) {
+            ESP_LOGW(TAG, "%lu input/WiFi messages dropped", (unsigned long)(stats.dropped - last_dropped));
+            last_dropped = stats.dropped;
+            bus_log_stats();
         }
     }
-}
\ No newline at end of file
+}
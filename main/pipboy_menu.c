@@ -0,0 +1,126 @@
+#include "pipboy_menu.h"
+#include "tft_driver.h"
+#include "esp_log.h"
+
+static const char *TAG = "MENU";
+
+#define MENU_NAV_Y       (TFT_HEIGHT - 25)
+#define MENU_NAV_SPACING 15
+#define MENU_NAV_PAD     5
+#define MENU_ROW_START_X 20
+#define MENU_ROW_START_Y 90
+#define MENU_ROW_HEIGHT  25
+
+// --- Tree ---
+#define MENU_CHILDREN(list) .children = list, .child_count = sizeof(list) / sizeof(list[0])
+
+static const menu_id_t root_children[] = {MENU_WIFI, MENU_AUDIO, MENU_POWER};
+static const menu_id_t wifi_children[] = {MENU_WIFI_CONNECT, MENU_WIFI_BROKER, MENU_WIFI_LOG, MENU_WIFI_BACK};
+
+static const menu_node_t menu_nodes[MENU_NODE_COUNT] = {
+    [MENU_ROOT] = {.label = "PIP-BOY MENU", MENU_CHILDREN(root_children)},
+
+    [MENU_WIFI]  = {.label = "1. WIFI", .title = "NETWORK CONFIG", .action = MENU_ACTION_OPEN,
+                    .view = MENU_VIEW_LIST, MENU_CHILDREN(wifi_children)},
+    [MENU_AUDIO] = {.label = "2. AUDIO", .action = MENU_ACTION_AUDIO_DEMO, .view = MENU_VIEW_AUDIO},
+    [MENU_POWER] = {.label = "3. POWER", .action = MENU_ACTION_HALT, .view = MENU_VIEW_POWER},
+
+    [MENU_WIFI_CONNECT] = {.label = "1. CONNECT WIFI", .action = MENU_ACTION_WIFI_TOGGLE, .status = MENU_STATUS_WIFI},
+    [MENU_WIFI_BROKER]  = {.label = "2. CONNECT BROKER", .action = MENU_ACTION_BROKER_TOGGLE, .status = MENU_STATUS_BROKER},
+    [MENU_WIFI_LOG]     = {.label = "3. SYSTEM LOG", .action = MENU_ACTION_SYSTEM_LOG},
+    [MENU_WIFI_BACK]    = {.label = "4. BACK", .action = MENU_ACTION_BACK},
+};
+
+const menu_node_t *menu_node(menu_id_t id) {
+    return &menu_nodes[id];
+}
+
+menu_id_t menu_child(menu_id_t parent, int index) {
+    return menu_nodes[parent].children[index];
+}
+
+int menu_child_count(menu_id_t parent) {
+    return menu_nodes[parent].child_count;
+}
+
+int menu_wrap(menu_id_t parent, int index, int step) {
+    int count = menu_nodes[parent].child_count;
+    return ((index + step) % count + count) % count;
+}
+
+void menu_activate(const menu_action_fn *actions, menu_id_t id) {
+    menu_action_fn fn = actions[menu_nodes[id].action];
+    ESP_LOGI(TAG, "Selected '%s'", menu_nodes[id].label);
+    if (fn) {
+        fn(id);
+    }
+}
+
+void menu_get_status(const menu_status_fn *providers, menu_id_t id, menu_status_t *out) {
+    menu_status_fn fn = providers[menu_nodes[id].status];
+    *out = (menu_status_t){NULL, 0};
+    if (fn) {
+        fn(out);
+    }
+}
+
+// --- Layout Cache ---
+static menu_rect_t menu_rects[MENU_NODE_COUNT];
+
+static void menu_layout_tabs(const menu_node_t *parent) {
+    int textWidth[MENU_MAX_CHILDREN];
+    int total = -MENU_NAV_SPACING;
+    for (int i = 0; i < parent->child_count; i++) {
+        textWidth[i] = tft_get_text_width(menu_nodes[parent->children[i]].label, MENU_TEXT_SIZE);
+        total += textWidth[i] + MENU_NAV_SPACING;
+    }
+    if (total > TFT_WIDTH) {
+        ESP_LOGW(TAG, "Nav bar is %d px wide, wider than the screen", total);
+    }
+
+    int x = (TFT_WIDTH - total) / 2;
+    int textHeight = tft_get_font()->height * MENU_TEXT_SIZE;
+    for (int i = 0; i < parent->child_count; i++) {
+        menu_rects[parent->children[i]] = (menu_rect_t){
+            .x = x - MENU_NAV_PAD, .y = MENU_NAV_Y - MENU_NAV_PAD,
+            .w = textWidth[i] + 2 * MENU_NAV_PAD, .h = textHeight + 2 * MENU_NAV_PAD,
+            .textX = x, .textY = MENU_NAV_Y,
+        };
+        x += textWidth[i] + MENU_NAV_SPACING;
+    }
+}
+
+// Rows don't overlap, so each one can be repainted on its own
+static void menu_layout_rows(const menu_node_t *parent) {
+    for (int i = 0; i < parent->child_count; i++) {
+        int y = MENU_ROW_START_Y + i * MENU_ROW_HEIGHT;
+        menu_rects[parent->children[i]] = (menu_rect_t){
+            .x = MENU_ROW_START_X - 5, .y = y - 5,
+            .w = TFT_WIDTH - MENU_ROW_START_X + 10, .h = MENU_ROW_HEIGHT,
+            .textX = MENU_ROW_START_X + 10, .textY = y + 4,
+        };
+    }
+}
+
+void menu_layout_init(void) {
+    for (int id = 0; id < MENU_NODE_COUNT; id++) {
+        const menu_node_t *node = &menu_nodes[id];
+        if (node->child_count == 0) {
+            continue;
+        }
+        if (node->child_count > MENU_MAX_CHILDREN) {
+            ESP_LOGE(TAG, "'%s' has %d items, more than fit on screen", node->label, node->child_count);
+            continue;
+        }
+
+        if (id == MENU_ROOT) {
+            menu_layout_tabs(node);
+        } else {
+            menu_layout_rows(node);
+        }
+    }
+}
+
+const menu_rect_t *menu_rect(menu_id_t id) {
+    return &menu_rects[id];
+}
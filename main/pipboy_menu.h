@@ -0,0 +1,106 @@
+#ifndef PIPBOY_MENU_H
+#define PIPBOY_MENU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Declarative menu tree. Nodes are a const table indexed by menu_id_t; each
+// names its children, the action run when it is activated, the view its tab
+// shows and the status provider of its row. Front ends map those ids to
+// functions through tables of their own, so handling input or drawing a
+// screen is one lookup however many tabs there are. Item rectangles are laid
+// out once by menu_layout_init(), never while drawing.
+
+// --- Nodes ---
+typedef enum {
+    MENU_ROOT,          // Children are the nav bar tabs
+    MENU_WIFI,
+    MENU_AUDIO,
+    MENU_POWER,
+    MENU_WIFI_CONNECT,
+    MENU_WIFI_BROKER,
+    MENU_WIFI_LOG,
+    MENU_WIFI_BACK,
+    MENU_NODE_COUNT
+} menu_id_t;
+
+typedef enum {
+    MENU_ACTION_NONE,
+    MENU_ACTION_OPEN,           // List the node's children as a sub-menu
+    MENU_ACTION_BACK,           // Close the sub-menu
+    MENU_ACTION_AUDIO_DEMO,
+    MENU_ACTION_HALT,
+    MENU_ACTION_WIFI_TOGGLE,
+    MENU_ACTION_BROKER_TOGGLE,
+    MENU_ACTION_SYSTEM_LOG,
+    MENU_ACTION_COUNT
+} menu_action_t;
+
+// Content pane of a tab while it is selected
+typedef enum {
+    MENU_VIEW_NONE,
+    MENU_VIEW_LIST,             // Its children, as the sub-menu shows them
+    MENU_VIEW_AUDIO,
+    MENU_VIEW_POWER,
+    MENU_VIEW_COUNT
+} menu_view_t;
+
+// Text shown at the right of a row
+typedef enum {
+    MENU_STATUS_NONE,
+    MENU_STATUS_WIFI,
+    MENU_STATUS_BROKER,
+    MENU_STATUS_COUNT
+} menu_status_id_t;
+
+typedef struct {
+    const char *label;
+    const char *title;          // Sub-menu header (MENU_ACTION_OPEN)
+    menu_action_t action;
+    menu_view_t view;
+    menu_status_id_t status;
+    const menu_id_t *children;
+    uint8_t child_count;
+} menu_node_t;
+
+#define MENU_MAX_CHILDREN 4 // Rows that fit between the header and the nav bar
+
+// --- Front End Tables ---
+// Indexed by menu_action_t / menu_status_id_t; NULL entries do nothing.
+// Actions get the activated node.
+typedef void (*menu_action_fn)(menu_id_t node);
+
+typedef struct {
+    const char *text;           // NULL = no status
+    uint16_t color;
+} menu_status_t;
+
+typedef void (*menu_status_fn)(menu_status_t *out);
+
+// Indexed by menu_view_t: draws the content pane of a tab
+typedef void (*menu_view_fn)(menu_id_t tab);
+
+// --- Tree ---
+const menu_node_t *menu_node(menu_id_t id);
+menu_id_t menu_child(menu_id_t parent, int index);
+int menu_child_count(menu_id_t parent);
+// index + step, wrapping around the parent's children
+int menu_wrap(menu_id_t parent, int index, int step);
+void menu_activate(const menu_action_fn *actions, menu_id_t id);
+void menu_get_status(const menu_status_fn *providers, menu_id_t id, menu_status_t *out);
+
+// --- Layout Cache ---
+// Nav tabs are centred as a group along the bottom bar; every other node's
+// children are stacked as rows below the sub-menu header
+#define MENU_TEXT_SIZE 2
+
+typedef struct {
+    int16_t x, y, w, h;         // Area the item clears and owns
+    int16_t textX, textY;
+} menu_rect_t;
+
+// Measures every label; call once the font is set
+void menu_layout_init(void);
+const menu_rect_t *menu_rect(menu_id_t id);
+
+#endif // PIPBOY_MENU_H
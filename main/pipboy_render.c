@@ -1,18 +1,28 @@
+#include <string.h>
 #include "pipboy_render.h"
 #include "pipboy_common.h"
 #include "tft_driver.h"
+#include "pipboy_clock.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "esp_log.h"
-#include "esp_timer.h"
 
 static const char *TAG = "PIPBOY_RENDER";
 
+// Clock callback: each minute boundary, and whenever the time is set
+static void status_changed(bool save_due) {
+    bus_mark_dirty(BUS_RENDER, BUS_DIRTY_STATUS);
+    if (save_due) {
+        bus_mark_dirty(BUS_LOGIC, BUS_DIRTY_CLOCK);
+    }
+}
+
 // Your rendering functions here...
 void tft_render_task(void *pvParameter) {
     ESP_LOGI(TAG, "TFT Render Task started.");
-    int trigger_index;
+    bus_register(BUS_RENDER);
+    clock_init(status_changed);
     
     // Initial full menu draw should happen after splash
     if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
@@ -21,6 +31,10 @@ void tft_render_task(void *pvParameter) {
     }
 
     while (1) {
+        // Woken by dirty bits, or at the animation rate while animating
+        bool animating = g_state.isDemoActive && g_state.currentMenuIndex == 1 && !g_state.isSubMenuActive;
+        uint32_t dirty = bus_wait(BUS_RENDER, animating ? pdMS_TO_TICKS(30) : portMAX_DELAY);
+
         if (g_state.isSystemHalted) {
             // System halt sequence
             if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
@@ -31,8 +45,8 @@ void tft_render_task(void *pvParameter) {
             vTaskDelay(portMAX_DELAY);
         }
 
-        // 1. Check for Menu Redraw Trigger
-        if (xQueueReceive(menu_update_queue, &trigger_index, pdMS_TO_TICKS(10)) == pdTRUE) {
+        // 1. Redraw for state changes (any number of them since the last frame)
+        if (dirty & (BUS_DIRTY_MENU | BUS_DIRTY_DEMO)) {
             if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
                 // Redraw logic based on current state
                 if (!g_state.isDemoActive && !g_state.isSubMenuActive) {
@@ -55,39 +69,41 @@ void tft_render_task(void *pvParameter) {
             }
         }
         
-        // 3. Status Bar Refresh
-        static uint64_t last_status_update = 0;
-        uint64_t current_time = esp_timer_get_time() / 1000;
-        
-        if (!g_state.isDemoActive && !g_state.isSystemHalted && 
-            (current_time - last_status_update) > 500) {
-            if (xSemaphoreTake(tft_mutex, pdMS_TO_TICKS(1)) == pdTRUE) {
+        // 3. Status Bar: minute ticks and Wi-Fi / broker changes only
+        if (!g_state.isDemoActive && !g_state.isSystemHalted && (dirty & BUS_DIRTY_STATUS)) {
+            if (xSemaphoreTake(tft_mutex, portMAX_DELAY) == pdTRUE) {
                 draw_clock(); 
                 xSemaphoreGive(tft_mutex);
-                last_status_update = current_time;
             }
         }
-
-        vTaskDelay(pdMS_TO_TICKS(30));
     }
 }
 
 // Implement all your drawing functions here...
+// Each field is redrawn only when its text changed since it was last drawn
 void draw_clock() {
-    // In a real IDF app, use esp_sntp or gettimeofday() for real time
-    tft_draw_filled_rect(TFT_WIDTH - 80, 0, 80, 18, ST77XX_BLACK);
-    // Use a fixed time string for the mock
-    tft_draw_text(TFT_WIDTH - 45, 5, "12:00", 1, PB_GREEN); 
+    static char shown_time[6], shown_wifi[6], shown_broker[6];
+    char time_text[6];
+    clock_format_hhmm(time_text);
 
     // Draw connection status icon/text near the clock
     EventBits_t uxBits = xEventGroupGetBits(wifi_event_group);
     bool is_connected = (uxBits & WIFI_CONNECTED_BIT) != 0;
-    
-    tft_draw_filled_rect(TFT_WIDTH - 120, 0, 40, 18, ST77XX_BLACK);
-    if (is_connected) {
-        tft_draw_text(TFT_WIDTH - 110, 5, "WIFI+", 1, PB_GREEN);
-    } else {
-        tft_draw_text(TFT_WIDTH - 110, 5, "WIFI-", 1, PB_DARK_GREEN); 
+    const char *wifi_text = is_connected ? "WIFI+" : "WIFI-";
+    const char *broker_text = g_state.isBrokerConnected ? "MQTT+" : "MQTT-";
+
+    if (strcmp(time_text, shown_time) != 0) {
+        tft_draw_text_bg(TFT_WIDTH - 45, 5, time_text, 1, PB_GREEN, ST77XX_BLACK);
+        strcpy(shown_time, time_text);
+    }
+    if (strcmp(wifi_text, shown_wifi) != 0) {
+        tft_draw_text_bg(TFT_WIDTH - 110, 5, wifi_text, 1, is_connected ? PB_GREEN : PB_DARK_GREEN, ST77XX_BLACK);
+        strcpy(shown_wifi, wifi_text);
+    }
+    if (strcmp(broker_text, shown_broker) != 0) {
+        tft_draw_text_bg(TFT_WIDTH - 150, 5, broker_text, 1,
+                         g_state.isBrokerConnected ? PB_GREEN : PB_DARK_GREEN, ST77XX_BLACK);
+        strcpy(shown_broker, broker_text);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/event_groups.h"
+#include "pipboy_bus.h"
 
 // --- PIN Definitions (Adjust to your Kconfig settings) ---
 #define PIN_TFT_CS CONFIG_PIN_TFT_CS
@@ -31,18 +32,6 @@ extern EventGroupHandle_t g_wifi_event_group;
 #define WIFI_FAIL_BIT BIT1
 #define WIFI_TOGGLE_BIT BIT2
 
-// --- Encoder Event Data Structure ---
-typedef enum {
-    ENC_DIR_NONE,
-    ENC_DIR_CW,
-    ENC_DIR_CCW
-} encoder_direction_t;
-
-typedef struct {
-    encoder_direction_t direction;
-    bool button_press;
-} encoder_event_t;
-
 // --- Global Application State ---
 typedef struct {
     int currentMenuIndex;
@@ -56,15 +45,8 @@ typedef struct {
 // --- External References to Global Objects ---
 extern menu_state_t g_state;
 extern SemaphoreHandle_t g_tft_mutex;
-extern QueueHandle_t g_encoder_queue;
-extern QueueHandle_t g_menu_update_queue;
-
-// Menu Text Data
-extern const char* MENU_ITEMS[];
-extern const int MENU_SIZE;
-extern const char* WIFI_SUB_MENU_ITEMS[];
-extern const int WIFI_SUB_MENU_SIZE;
 
+// Menu items and actions come from the menu tree (pipboy_menu.h)
 
 // --- Task Prototypes ---
 void encoder_task(void *pvParameter);
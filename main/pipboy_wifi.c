@@ -8,6 +8,8 @@
 #include "esp_wifi.h"
 #include "esp_netif.h"
 #include "pipboy_state.h"
+#include "pipboy_bus.h"
+#include "pipboy_clock.h"
 
 static const char *TAG = "WIFI_TASK";
 
@@ -25,16 +27,16 @@ static void event_handler(void* arg, esp_event_base_t event_base, int32_t event_
     if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
         ESP_LOGI(TAG, "WiFi Disconnected");
         xEventGroupClearBits(g_wifi_event_group, WIFI_CONNECTED_BIT);
-        // Trigger a redraw in case we are in the WiFi menu
-        int redraw_flag = 1; 
-        xQueueSend(g_menu_update_queue, &redraw_flag, portMAX_DELAY);
+        // Runs on the system event loop: posting never blocks it
+        bus_msg_t msg = {.type = BUS_MSG_WIFI, .wifi = {.connected = false}};
+        bus_post(BUS_LOGIC, &msg);
     } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
         ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
         ESP_LOGI(TAG, "Got IP: " IPSTR, IP2STR(&event->ip_info.ip));
         xEventGroupSetBits(g_wifi_event_group, WIFI_CONNECTED_BIT);
-        // Trigger a redraw to show the connection status
-        int redraw_flag = 1; 
-        xQueueSend(g_menu_update_queue, &redraw_flag, portMAX_DELAY);
+        clock_sntp_start();
+        bus_msg_t msg = {.type = BUS_MSG_WIFI, .wifi = {.connected = true}};
+        bus_post(BUS_LOGIC, &msg);
     }
 }
 
@@ -0,0 +1,81 @@
+// Generated by tools/img2tft.py from vault_tec.png. Do not edit.
+// 180x91, 2 colours, 949 bytes of run data
+// (32760 bytes as raw RGB565).
+
+#include "tft_image.h"
+
+static const uint16_t img_vault_tec_palette[] = {
+    0x0000, 0x07E0,
+};
+
+static const uint8_t img_vault_tec_data[] = {
+    0x00, 0x44, 0x1D, 0x00, 0x92, 0x01, 0x15, 0x0D, 0x15, 0x00, 0x8A, 0x01, 0x13, 0x00, 0x07, 0x13,
+    0x00, 0x84, 0x01, 0x13, 0x00, 0x0D, 0x13, 0x00, 0x7F, 0x12, 0x00, 0x13, 0x12, 0x00, 0x7B, 0x12,
+    0x00, 0x17, 0x12, 0x00, 0x77, 0x12, 0x00, 0x1B, 0x12, 0x00, 0x73, 0x12, 0x00, 0x1F, 0x12, 0x00,
+    0x70, 0x12, 0x00, 0x21, 0x12, 0x00, 0x6E, 0x11, 0x00, 0x25, 0x11, 0x00, 0x6B, 0x12, 0x00, 0x06,
+    0x1B, 0x00, 0x06, 0x12, 0x00, 0x68, 0x12, 0x00, 0x02, 0x15, 0x0B, 0x15, 0x00, 0x02, 0x12, 0x00,
+    0x66, 0x12, 0x00, 0x00, 0x13, 0x00, 0x05, 0x13, 0x00, 0x00, 0x12, 0x00, 0x64, 0x12, 0x0F, 0x13,
+    0x00, 0x09, 0x13, 0x0F, 0x12, 0x00, 0x62, 0x12, 0x0E, 0x12, 0x00, 0x0F, 0x12, 0x0E, 0x12, 0x00,
+    0x60, 0x12, 0x0E, 0x11, 0x00, 0x13, 0x11, 0x0E, 0x12, 0x00, 0x5E, 0x12, 0x0D, 0x12, 0x00, 0x15,
+    0x12, 0x0D, 0x12, 0x00, 0x5D, 0x11, 0x0D, 0x11, 0x00, 0x19, 0x11, 0x0D, 0x11, 0x00, 0x5C, 0x11,
+    0x0C, 0x12, 0x00, 0x1B, 0x12, 0x0C, 0x11, 0x00, 0x5A, 0x11, 0x0C, 0x12, 0x00, 0x1D, 0x12, 0x0C,
+    0x11, 0x00, 0x58, 0x12, 0x0B, 0x12, 0x00, 0x02, 0x1B, 0x00, 0x02, 0x12, 0x0B, 0x12, 0x00, 0x57,
+    0x11, 0x0B, 0x12, 0x00, 0x00, 0x14, 0x09, 0x14, 0x00, 0x00, 0x12, 0x0B, 0x11, 0x00, 0x56, 0x11,
+    0x0B, 0x12, 0x0E, 0x13, 0x00, 0x01, 0x13, 0x0E, 0x12, 0x0B, 0x11, 0x00, 0x55, 0x11, 0x0B, 0x11,
+    0x0E, 0x12, 0x00, 0x05, 0x12, 0x0E, 0x11, 0x0B, 0x11, 0x00, 0x54, 0x11, 0x0B, 0x11, 0x0D, 0x12,
+    0x00, 0x09, 0x12, 0x0D, 0x11, 0x0B, 0x11, 0x00, 0x53, 0x11, 0x0A, 0x11, 0x0D, 0x11, 0x00, 0x0D,
+    0x11, 0x0D, 0x11, 0x0A, 0x11, 0x00, 0x52, 0x11, 0x0B, 0x11, 0x0B, 0x12, 0x00, 0x0F, 0x12, 0x0B,
+    0x11, 0x0B, 0x11, 0x00, 0x51, 0x11, 0x0A, 0x11, 0x0B, 0x12, 0x00, 0x11, 0x12, 0x0B, 0x11, 0x0A,
+    0x11, 0x00, 0x50, 0x11, 0x0A, 0x11, 0x0B, 0x12, 0x00, 0x13, 0x12, 0x0B, 0x11, 0x0A, 0x11, 0x00,
+    0x4F, 0x11, 0x0A, 0x11, 0x0B, 0x11, 0x00, 0x15, 0x11, 0x0B, 0x11, 0x0A, 0x11, 0x00, 0x29, 0x10,
+    0x36, 0x07, 0x17, 0x06, 0x10, 0x36, 0x00, 0x04, 0x10, 0x36, 0x04, 0x13, 0x07, 0x13, 0x03, 0x10,
+    0x36, 0x00, 0x04, 0x10, 0x36, 0x02, 0x12, 0x0D, 0x12, 0x01, 0x10, 0x36, 0x00, 0x04, 0x10, 0x36,
+    0x01, 0x11, 0x00, 0x01, 0x10, 0x37, 0x00, 0x04, 0x10, 0x37, 0x00, 0x03, 0x10, 0x36, 0x00, 0x04,
+    0x10, 0x36, 0x00, 0x04, 0x10, 0x36, 0x00, 0x04, 0x10, 0x36, 0x00, 0x04, 0x10, 0x36, 0x00, 0x04,
+    0x10, 0x36, 0x00, 0x04, 0x10, 0x36, 0x00, 0x28, 0x11, 0x09, 0x11, 0x09, 0x11, 0x0A, 0x11, 0x00,
+    0x09, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x4A, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09,
+    0x11, 0x00, 0x0B, 0x11, 0x09, 0x11, 0x09, 0x11, 0x0A, 0x11, 0x00, 0x49, 0x11, 0x09, 0x11, 0x09,
+    0x12, 0x09, 0x11, 0x00, 0x0B, 0x11, 0x09, 0x12, 0x09, 0x11, 0x09, 0x11, 0x00, 0x49, 0x11, 0x09,
+    0x11, 0x09, 0x11, 0x0A, 0x11, 0x00, 0x0B, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x49,
+    0x11, 0x09, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x0D, 0x11, 0x09, 0x11, 0x09, 0x11, 0x09, 0x11,
+    0x00, 0x1C, 0x10, 0x90, 0x0B, 0x00, 0x1D, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x0B,
+    0x11, 0x09, 0x11, 0x09, 0x11, 0x0A, 0x11, 0x00, 0x4A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x0A, 0x11,
+    0x00, 0x09, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x4B, 0x11, 0x09, 0x11, 0x09, 0x11,
+    0x0A, 0x11, 0x00, 0x09, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x09, 0x11, 0x00, 0x4B, 0x11, 0x09, 0x11,
+    0x0A, 0x11, 0x0A, 0x11, 0x00, 0x07, 0x11, 0x0A, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x00, 0x4B, 0x11,
+    0x09, 0x11, 0x0A, 0x11, 0x0B, 0x11, 0x00, 0x05, 0x11, 0x0B, 0x11, 0x0A, 0x11, 0x09, 0x11, 0x00,
+    0x4B, 0x11, 0x0A, 0x11, 0x09, 0x12, 0x0B, 0x11, 0x00, 0x03, 0x11, 0x0B, 0x12, 0x09, 0x11, 0x0A,
+    0x11, 0x00, 0x4C, 0x11, 0x09, 0x11, 0x0A, 0x11, 0x0C, 0x11, 0x00, 0x01, 0x11, 0x0C, 0x11, 0x0A,
+    0x11, 0x09, 0x11, 0x00, 0x4D, 0x11, 0x09, 0x12, 0x0A, 0x11, 0x0C, 0x12, 0x0D, 0x12, 0x0C, 0x11,
+    0x0A, 0x12, 0x09, 0x11, 0x00, 0x4D, 0x11, 0x0A, 0x11, 0x0A, 0x11, 0x0E, 0x13, 0x07, 0x13, 0x0E,
+    0x11, 0x0A, 0x11, 0x0A, 0x11, 0x00, 0x4E, 0x11, 0x09, 0x11, 0x0B, 0x11, 0x00, 0x00, 0x17, 0x00,
+    0x00, 0x11, 0x0B, 0x11, 0x09, 0x11, 0x00, 0x4F, 0x11, 0x0A, 0x11, 0x0B, 0x11, 0x00, 0x15, 0x11,
+    0x0B, 0x11, 0x0A, 0x11, 0x00, 0x4F, 0x11, 0x0A, 0x11, 0x0B, 0x12, 0x00, 0x13, 0x12, 0x0B, 0x11,
+    0x0A, 0x11, 0x00, 0x50, 0x11, 0x0A, 0x11, 0x0B, 0x12, 0x00, 0x11, 0x12, 0x0B, 0x11, 0x0A, 0x11,
+    0x00, 0x51, 0x11, 0x0B, 0x11, 0x0B, 0x12, 0x00, 0x0F, 0x12, 0x0B, 0x11, 0x0B, 0x11, 0x00, 0x52,
+    0x11, 0x0A, 0x11, 0x0D, 0x11, 0x00, 0x0D, 0x11, 0x0D, 0x11, 0x0A, 0x11, 0x00, 0x53, 0x11, 0x0B,
+    0x11, 0x0D, 0x12, 0x00, 0x09, 0x12, 0x0D, 0x11, 0x0B, 0x11, 0x00, 0x54, 0x11, 0x0B, 0x11, 0x0E,
+    0x12, 0x00, 0x05, 0x12, 0x0E, 0x11, 0x0B, 0x11, 0x00, 0x55, 0x11, 0x0B, 0x12, 0x0E, 0x13, 0x00,
+    0x01, 0x13, 0x0E, 0x12, 0x0B, 0x11, 0x00, 0x56, 0x11, 0x0B, 0x12, 0x00, 0x00, 0x14, 0x09, 0x14,
+    0x00, 0x00, 0x12, 0x0B, 0x11, 0x00, 0x57, 0x12, 0x0B, 0x12, 0x00, 0x02, 0x1B, 0x00, 0x02, 0x12,
+    0x0B, 0x12, 0x00, 0x58, 0x11, 0x0C, 0x12, 0x00, 0x1D, 0x12, 0x0C, 0x11, 0x00, 0x5A, 0x11, 0x0C,
+    0x12, 0x00, 0x1B, 0x12, 0x0C, 0x11, 0x00, 0x5C, 0x11, 0x0D, 0x11, 0x00, 0x19, 0x11, 0x0D, 0x11,
+    0x00, 0x5D, 0x12, 0x0D, 0x12, 0x00, 0x15, 0x12, 0x0D, 0x12, 0x00, 0x5E, 0x12, 0x0E, 0x11, 0x00,
+    0x13, 0x11, 0x0E, 0x12, 0x00, 0x60, 0x12, 0x0E, 0x12, 0x00, 0x0F, 0x12, 0x0E, 0x12, 0x00, 0x62,
+    0x12, 0x0F, 0x13, 0x00, 0x09, 0x13, 0x0F, 0x12, 0x00, 0x64, 0x12, 0x00, 0x00, 0x13, 0x00, 0x05,
+    0x13, 0x00, 0x00, 0x12, 0x00, 0x66, 0x12, 0x00, 0x02, 0x15, 0x0B, 0x15, 0x00, 0x02, 0x12, 0x00,
+    0x68, 0x12, 0x00, 0x06, 0x1B, 0x00, 0x06, 0x12, 0x00, 0x6B, 0x11, 0x00, 0x25, 0x11, 0x00, 0x6E,
+    0x12, 0x00, 0x21, 0x12, 0x00, 0x70, 0x12, 0x00, 0x1F, 0x12, 0x00, 0x73, 0x12, 0x00, 0x1B, 0x12,
+    0x00, 0x77, 0x12, 0x00, 0x17, 0x12, 0x00, 0x7B, 0x12, 0x00, 0x13, 0x12, 0x00, 0x7F, 0x13, 0x00,
+    0x0D, 0x13, 0x00, 0x84, 0x01, 0x13, 0x00, 0x07, 0x13, 0x00, 0x8A, 0x01, 0x15, 0x0D, 0x15, 0x00,
+    0x92, 0x01, 0x1D, 0x00, 0x43,
+};
+
+const tft_image_t img_vault_tec = {
+    .width = 180,
+    .height = 91,
+    .palette_size = 2,
+    .palette = img_vault_tec_palette,
+    .data = img_vault_tec_data,
+    .data_size = sizeof(img_vault_tec_data),
+};
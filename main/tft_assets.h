@@ -0,0 +1,9 @@
+#ifndef TFT_ASSETS_H
+#define TFT_ASSETS_H
+
+#include "tft_image.h"
+
+// Artwork converted with tools/img2tft.py; sources are in assets/
+extern const tft_image_t img_vault_tec;  // 180x91 Vault-Tec symbol, PB_GREEN on black
+
+#endif // TFT_ASSETS_H
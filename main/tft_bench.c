@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <math.h>
+#include "tft_bench.h"
+#include "tft_driver.h"
+#include "fx_math.h"
+#include "esp_timer.h"
+
+typedef enum {
+    BENCH_FILL_SCREEN,
+    BENCH_FILL_RECT,
+    BENCH_LINE,
+    BENCH_CIRCLE,
+    BENCH_DISC,
+    BENCH_TEXT,
+    BENCH_TEXT_BG,
+} tft_bench_op_t;
+
+typedef struct {
+    const char *group;
+    const char *name;
+    tft_bench_op_t op;
+    int a, b, c, d; // Op-specific geometry
+} tft_bench_prim_t;
+
+static const char *bench_text = "PIP-BOY 3000";
+
+static const tft_bench_prim_t bench_prims[] = {
+    {"fill",   "screen",    BENCH_FILL_SCREEN, 0, 0, 0, 0},
+    {"fill",   "8x8",       BENCH_FILL_RECT,   100, 100, 8, 8},
+    {"fill",   "32x32",     BENCH_FILL_RECT,   100, 100, 32, 32},
+    {"fill",   "100x100",   BENCH_FILL_RECT,   100, 70, 100, 100},
+    {"fill",   "320x20",    BENCH_FILL_RECT,   0, 110, 320, 20},
+    {"line",   "h_200",     BENCH_LINE,        60, 120, 259, 120},
+    {"line",   "v_200",     BENCH_LINE,        160, 20, 160, 219},
+    {"line",   "45deg_200", BENCH_LINE,        60, 20, 259, 219},
+    {"line",   "shallow",   BENCH_LINE,        60, 110, 259, 130},  // ~6 degrees
+    {"line",   "steep",     BENCH_LINE,        150, 20, 170, 219},  // ~84 degrees
+    {"circle", "r10",       BENCH_CIRCLE,      160, 120, 10, 0},
+    {"circle", "r40",       BENCH_CIRCLE,      160, 120, 40, 0},
+    {"circle", "r100",      BENCH_CIRCLE,      160, 120, 100, 0},
+    {"disc",   "r10",       BENCH_DISC,        160, 120, 10, 0},
+    {"disc",   "r40",       BENCH_DISC,        160, 120, 40, 0},
+    {"disc",   "r100",      BENCH_DISC,        160, 120, 100, 0},
+    {"text",   "size1",     BENCH_TEXT,        20, 100, 1, 0},
+    {"text",   "size2",     BENCH_TEXT,        20, 100, 2, 0},
+    {"text",   "size3",     BENCH_TEXT,        20, 100, 3, 0},
+    {"text_bg", "size1",    BENCH_TEXT_BG,     20, 100, 1, 0},
+    {"text_bg", "size2",    BENCH_TEXT_BG,     20, 100, 2, 0},
+    {"text_bg", "size3",    BENCH_TEXT_BG,     20, 100, 3, 0},
+};
+
+static const char *const mode_names[] = {"direct", "framebuffer", "band", "indexed"};
+
+static void tft_bench_clear(void *arg) {
+    (void)arg;
+    tft_fill_screen(ST77XX_BLACK);
+    tft_flush();
+}
+
+static void tft_bench_draw_prim(void *arg) {
+    const tft_bench_prim_t *p = arg;
+
+    switch (p->op) {
+        case BENCH_FILL_SCREEN:
+            tft_fill_screen(PB_GREEN);
+            break;
+        case BENCH_FILL_RECT:
+            tft_draw_filled_rect(p->a, p->b, p->c, p->d, PB_GREEN);
+            break;
+        case BENCH_LINE:
+            tft_draw_line(p->a, p->b, p->c, p->d, PB_GREEN);
+            break;
+        case BENCH_CIRCLE:
+            tft_draw_circle(p->a, p->b, p->c, PB_GREEN);
+            break;
+        case BENCH_DISC:
+            tft_fill_circle(p->a, p->b, p->c, PB_GREEN);
+            break;
+        case BENCH_TEXT:
+            tft_draw_text(p->a, p->b, bench_text, p->c, PB_GREEN);
+            break;
+        case BENCH_TEXT_BG:
+            tft_draw_text_bg(p->a, p->b, bench_text, p->c, PB_GREEN, ST77XX_BLACK);
+            break;
+    }
+}
+
+void tft_bench_case(const char *group, const char *name, tft_bench_fn_t setup,
+                    tft_bench_fn_t fn, void *arg, int iterations) {
+    int64_t elapsed_us = 0;
+    uint64_t transactions = 0, bytes = 0, pixels = 0;
+
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    for (int i = 0; i < iterations; i++) {
+        if (setup) {
+            setup(arg);
+        }
+        tft_wait_done();
+        tft_stats_reset(); // Setup work must not count towards the case
+
+        int64_t start = esp_timer_get_time();
+        fn(arg);
+        tft_flush();
+        tft_wait_done();
+        elapsed_us += esp_timer_get_time() - start;
+
+        tft_stats_t stats;
+        tft_stats_get(&stats);
+        for (int p = 0; p < TFT_PRIM_COUNT; p++) {
+            transactions += stats.prim[p].transactions;
+            bytes += stats.prim[p].bytes;
+            pixels += stats.prim[p].pixels;
+        }
+    }
+
+    double pixels_per_s = elapsed_us > 0 ? pixels * 1e6 / elapsed_us : 0;
+
+    printf("{\"bench\":\"%s\",\"case\":\"%s\",\"mode\":\"%s\",\"iters\":%d,\"us_per_call\":%.1f,"
+           "\"trans_per_call\":%.1f,\"bytes_per_call\":%.0f,\"pixels_per_call\":%.0f,\"pixels_per_s\":%.0f}\n",
+           group, name, mode_names[tft_get_render_mode()], iterations, (double)elapsed_us / iterations,
+           (double)transactions / iterations, (double)bytes / iterations,
+           (double)pixels / iterations, pixels_per_s);
+}
+
+void tft_bench_primitives(int iterations) {
+    for (size_t i = 0; i < sizeof(bench_prims) / sizeof(bench_prims[0]); i++) {
+        const tft_bench_prim_t *p = &bench_prims[i];
+        tft_bench_case(p->group, p->name, tft_bench_clear, tft_bench_draw_prim, (void *)p, iterations);
+    }
+    tft_bench_clear(NULL);
+}
+
+// --- Trig ---
+#define BENCH_ANGLES     65536
+#define BENCH_CHUNK      256 // Angles of a turn computed per step
+#define BENCH_WAVE_COLS  320
+#define BENCH_RAD_PER_ANGLE (6.283185307179586 / BENCH_ANGLES)
+
+typedef enum {
+    BENCH_TRIG_SINF,
+    BENCH_TRIG_FX_SIN,
+    BENCH_TRIG_FX_BATCH,
+    BENCH_TRIG_WAVE_SINF,
+    BENCH_TRIG_WAVE_FX,
+} tft_bench_trig_op_t;
+
+static q15_t trig_out[BENCH_WAVE_COLS]; // One chunk of a turn, or one waveform
+static volatile int trig_sink; // Keeps the timed loops from being optimised out
+
+// Sines of angles start .. start + BENCH_CHUNK - 1 into trig_out
+static void tft_bench_trig_chunk(tft_bench_trig_op_t op, int start) {
+    switch (op) {
+        case BENCH_TRIG_SINF:
+            for (int i = 0; i < BENCH_CHUNK; i++) {
+                trig_out[i] = (q15_t)lrintf(sinf((start + i) * (float)BENCH_RAD_PER_ANGLE) * FX_Q15_ONE);
+            }
+            break;
+        case BENCH_TRIG_FX_SIN:
+            for (int i = 0; i < BENCH_CHUNK; i++) {
+                trig_out[i] = fx_sin((fx_angle_t)(start + i));
+            }
+            break;
+        case BENCH_TRIG_FX_BATCH:
+            fx_sin_batch(trig_out, BENCH_CHUNK, (fx_angle_t)start, 1);
+            break;
+        default:
+            break;
+    }
+}
+
+// One pass: every angle of a turn, chunk by chunk, or one waveform of
+// BENCH_WAVE_COLS columns as the audio demo computes it
+static void tft_bench_trig_pass(tft_bench_trig_op_t op, int pass) {
+    switch (op) {
+        case BENCH_TRIG_WAVE_SINF: {
+            float phase = pass * 0.1f;
+            for (int x = 0; x < BENCH_WAVE_COLS; x++) {
+                trig_out[x] = 120 + (int)(sinf(x * 0.05f + phase) * 50);
+            }
+            break;
+        }
+        case BENCH_TRIG_WAVE_FX:
+            fx_wave_batch(trig_out, BENCH_WAVE_COLS, (fx_angle_t)(pass * FX_ANGLE_RAD(0.1)),
+                          FX_ANGLE_RAD(0.05), 50, 120);
+            break;
+        default:
+            for (int a = 0; a < BENCH_ANGLES; a += BENCH_CHUNK) {
+                tft_bench_trig_chunk(op, a);
+                trig_sink += trig_out[pass % BENCH_CHUNK];
+            }
+            return;
+    }
+    trig_sink += trig_out[pass % BENCH_WAVE_COLS];
+}
+
+// Distance from sin() in double precision, in Q15 LSBs, over a whole turn
+// recomputed chunk by chunk outside the timed passes
+static void tft_bench_trig_error(tft_bench_trig_op_t op, double *max_err, double *mean_err) {
+    double worst = 0;
+    double sum = 0;
+    for (int a = 0; a < BENCH_ANGLES; a += BENCH_CHUNK) {
+        tft_bench_trig_chunk(op, a);
+        for (int i = 0; i < BENCH_CHUNK; i++) {
+            double err = fabs(trig_out[i] - sin((a + i) * BENCH_RAD_PER_ANGLE) * FX_Q15_ONE);
+            sum += err;
+            if (err > worst) worst = err;
+        }
+    }
+    *max_err = worst;
+    *mean_err = sum / BENCH_ANGLES;
+}
+
+void tft_bench_trig(int iterations) {
+    static const struct {
+        const char *name;
+        tft_bench_trig_op_t op;
+        int calls; // Sines per pass
+    } cases[] = {
+        {"sinf",         BENCH_TRIG_SINF,      BENCH_ANGLES},
+        {"fx_sin",       BENCH_TRIG_FX_SIN,    BENCH_ANGLES},
+        {"fx_sin_batch", BENCH_TRIG_FX_BATCH,  BENCH_ANGLES},
+        {"wave_sinf",    BENCH_TRIG_WAVE_SINF, BENCH_WAVE_COLS},
+        {"wave_fx",      BENCH_TRIG_WAVE_FX,   BENCH_WAVE_COLS},
+    };
+
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        int64_t start = esp_timer_get_time();
+        for (int pass = 0; pass < iterations; pass++) {
+            tft_bench_trig_pass(cases[i].op, pass);
+        }
+        int64_t elapsed_us = esp_timer_get_time() - start;
+
+        // Waveform cases report no error
+        char max_err[16] = "null";
+        char mean_err[16] = "null";
+        if (cases[i].calls == BENCH_ANGLES) {
+            double worst, mean;
+            tft_bench_trig_error(cases[i].op, &worst, &mean);
+            snprintf(max_err, sizeof(max_err), "%.2f", worst);
+            snprintf(mean_err, sizeof(mean_err), "%.3f", mean);
+        }
+
+        printf("{\"bench\":\"trig\",\"case\":\"%s\",\"iters\":%d,\"us_per_call\":%.1f,"
+               "\"ns_per_sin\":%.1f,\"max_err_lsb\":%s,\"mean_err_lsb\":%s}\n",
+               cases[i].name, iterations, (double)elapsed_us / iterations,
+               elapsed_us * 1000.0 / ((double)iterations * cases[i].calls), max_err, mean_err);
+    }
+}
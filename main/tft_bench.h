@@ -0,0 +1,31 @@
+#ifndef TFT_BENCH_H
+#define TFT_BENCH_H
+
+#include <stdint.h>
+
+// Rendering micro-benchmarks. Every case prints one JSON object per line on
+// stdout (no log prefix) so runs can be collected and compared by scripts:
+//
+//   {"bench":"line","case":"45deg_200","mode":"direct","iters":50,"us_per_call":41.2,
+//    "trans_per_call":3.0,"bytes_per_call":412,"pixels_per_call":200,"pixels_per_s":4854368}
+//
+// Transaction, byte and pixel counts come from the draw statistics and are
+// zero unless CONFIG_TFT_STATS is enabled. Time is wall time per call including
+// tft_flush() and waiting for the bus, i.e. the frame time for screen cases.
+
+typedef void (*tft_bench_fn_t)(void *arg);
+
+// Times `fn` over `iterations` calls. `setup` (optional) runs before each call
+// outside the timed region, e.g. to restore the state the call draws over.
+void tft_bench_case(const char *group, const char *name, tft_bench_fn_t setup,
+                    tft_bench_fn_t fn, void *arg, int iterations);
+
+// Fills of several sizes, lines at several slopes, circles by radius and text
+// at sizes 1-3, in the current render mode
+void tft_bench_primitives(int iterations);
+
+// Sine from libm against the fx_math table: a full turn per call (time per
+// sine and worst error in Q15 LSBs) and the audio demo's 320 column waveform
+void tft_bench_trig(int iterations);
+
+#endif
@@ -1,7 +1,13 @@
+#include <string.h>
+#include <stdlib.h>
 #include "tft_driver.h"
 #include "esp_log.h"
+#include "esp_attr.h"
 #include "driver/spi_master.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 static const char *TAG = "TFT_DRIVER";
 
@@ -13,12 +19,15 @@ static const char *TAG = "TFT_DRIVER";
 #define TFT_DC   GPIO_NUM_16
 
 static spi_device_handle_t spi;
+static const tft_font_t *font = &tft_font_6x8;
 
 // ST7789 commands
 #define ST7789_NOP     0x00
 #define ST7789_SWRESET 0x01
 #define ST7789_SLPIN   0x10
 #define ST7789_SLPOUT  0x11
+#define ST7789_PTLON   0x12
+#define ST7789_NORON   0x13
 #define ST7789_INVOFF  0x20
 #define ST7789_INVON   0x21
 #define ST7789_DISPOFF 0x28
@@ -26,50 +35,250 @@ static spi_device_handle_t spi;
 #define ST7789_CASET   0x2A
 #define ST7789_RASET   0x2B
 #define ST7789_RAMWR   0x2C
+#define ST7789_PTLAR   0x30
+#define ST7789_VSCRDEF 0x33
+#define ST7789_TEOFF   0x34
+#define ST7789_TEON    0x35
 #define ST7789_MADCTL  0x36
+#define ST7789_VSCSAD  0x37
+#define ST7789_IDMOFF  0x38
+#define ST7789_IDMON   0x39
+#define ST7789_COLMOD  0x3A
 
-static void tft_write_command(uint8_t cmd) {
-    gpio_set_level(TFT_DC, 0);
-    spi_transaction_t t = {
-        .length = 8,
-        .tx_buffer = &cmd,
-    };
-    spi_device_polling_transmit(spi, &t);
+// --- Command list engine ---
+// Each entry is one command byte followed by its parameter block. The DC line
+// is driven by tft_spi_pre_transfer_cb() from the transaction's user field, so
+// a command costs at most two transactions and no explicit GPIO writes.
+#define TFT_CMD_MAX_PARAMS 14
+#define TFT_CMD_END        0xFF // Table terminator (not a valid ST7789 command here)
+
+typedef struct {
+    uint8_t cmd;
+    uint8_t len;                        // Number of bytes in data[]
+    uint16_t delay_ms;                  // Delay after the command has been sent
+    uint8_t data[TFT_CMD_MAX_PARAMS];
+} tft_cmd_t;
+
+#define TFT_DC_COMMAND ((void *)0)
+#define TFT_DC_DATA    ((void *)1)
+
+static const tft_cmd_t st7789_init_cmds[] = {
+    {ST7789_SWRESET, 0, 150, {0}},
+    {ST7789_SLPOUT,  0, 255, {0}},
+    {ST7789_MADCTL,  1, 0,   {0x08}}, // RGB color filter panel
+    {ST7789_COLMOD,  1, 0,   {0x55}}, // 16 bits per pixel
+    {ST7789_INVON,   0, 10,  {0}},
+    {ST7789_NORON,   0, 10,  {0}},
+    {ST7789_DISPON,  0, 100, {0}},
+    {TFT_CMD_END,    0, 0,   {0}},
+};
+
+// Power state (see Power modes). NORON ends both partial and scroll mode.
+static int64_t sleep_cmd_us; // Time of the last SLPIN/SLPOUT
+static bool partial_mode;
+
+// Last window sent to the panel; CASET/RASET are skipped when unchanged.
+static uint16_t win_x1 = 0xFFFF, win_x2 = 0xFFFF;
+static uint16_t win_y1 = 0xFFFF, win_y2 = 0xFFFF;
+
+// --- Queued transfer engine ---
+// Every transaction goes through spi_device_queue_trans() from a small ring of
+// descriptors, so the CPU only blocks when the queue is full or when a DMA line
+// buffer it wants to overwrite is still on the wire.
+#define TFT_QUEUE_SIZE 7
+
+static spi_transaction_t trans_ring[TFT_QUEUE_SIZE];
+static int trans_head;
+static uint32_t trans_queued; // Sequence number of the last queued transaction
+static uint32_t trans_done;   // Sequence number of the last completed transaction
+
+// --- DMA line buffers (ping-pong) ---
+#define TFT_DMA_BUF_COUNT  2
+
+static uint16_t *dma_buf[TFT_DMA_BUF_COUNT];
+static uint32_t dma_buf_seq[TFT_DMA_BUF_COUNT];       // Last transaction reading the buffer
+static uint32_t dma_buf_fill_len[TFT_DMA_BUF_COUNT];  // Pixels holding dma_buf_fill_color (0 = mixed)
+static uint16_t dma_buf_fill_color[TFT_DMA_BUF_COUNT];
+static int dma_buf_next;
+
+// --- Instrumentation ---
+// With CONFIG_TFT_STATS every public primitive opens a stats scope. Work done
+// by nested calls (e.g. the spans of a line) is attributed to the outermost
+// primitive; transactions outside any primitive count as TFT_PRIM_OTHER.
+// Time is CPU time inside the call, not wire time of the queued transfers.
+#if CONFIG_TFT_STATS
+typedef struct {
+    tft_prim_t prim;
+    int64_t start_us;
+} tft_stats_scope_t;
+
+static tft_stats_t stats_total;
+static tft_stats_t stats_frame;
+static tft_stats_t stats_last_frame;
+static int stats_depth;
+static tft_prim_t stats_prim;
+
+static tft_stats_scope_t tft_stats_scope_begin(tft_prim_t prim) {
+    tft_stats_scope_t scope = {prim, 0};
+    if (stats_depth++ == 0) {
+        stats_prim = prim;
+        stats_frame.prim[prim].calls++;
+        scope.start_us = esp_timer_get_time();
+    }
+    return scope;
 }
 
-static void tft_write_data(uint8_t data) {
-    gpio_set_level(TFT_DC, 1);
-    spi_transaction_t t = {
-        .length = 8,
-        .tx_buffer = &data,
-    };
-    spi_device_polling_transmit(spi, &t);
+static void tft_stats_scope_end(tft_stats_scope_t *scope) {
+    if (--stats_depth == 0) {
+        stats_frame.prim[scope->prim].time_us += esp_timer_get_time() - scope->start_us;
+    }
 }
 
-static void tft_write_data_16(uint16_t data) {
-    gpio_set_level(TFT_DC, 1);
-    uint8_t buffer[2] = {data >> 8, data & 0xFF};
-    spi_transaction_t t = {
-        .length = 16,
-        .tx_buffer = buffer,
-    };
-    spi_device_polling_transmit(spi, &t);
+// Closes the stats scope on every return path of the enclosing function
+#define TFT_STATS_SCOPE(p) \
+    tft_stats_scope_t _stats_scope __attribute__((cleanup(tft_stats_scope_end))) = tft_stats_scope_begin(p)
+#define TFT_STATS_COUNT(field, n) \
+    (stats_frame.prim[stats_depth ? stats_prim : TFT_PRIM_OTHER].field += (n))
+#else
+#define TFT_STATS_SCOPE(p)        do {} while (0)
+#define TFT_STATS_COUNT(field, n) do {} while (0)
+#endif
+
+static void IRAM_ATTR tft_spi_pre_transfer_cb(spi_transaction_t *t) {
+    gpio_set_level(TFT_DC, (uint32_t)(uintptr_t)t->user);
+}
+
+static void tft_reap_one(void) {
+    spi_transaction_t *done;
+    ESP_ERROR_CHECK(spi_device_get_trans_result(spi, &done, portMAX_DELAY));
+    trans_done++;
+}
+
+// Blocks until the transaction with sequence number `seq` has completed
+static void tft_wait_seq(uint32_t seq) {
+    while ((int32_t)(seq - trans_done) > 0) {
+        tft_reap_one();
+    }
+}
+
+static spi_transaction_t *tft_trans_alloc(void) {
+    if (trans_queued - trans_done >= TFT_QUEUE_SIZE) {
+        tft_reap_one();
+    }
+    spi_transaction_t *t = &trans_ring[trans_head];
+    trans_head = (trans_head + 1) % TFT_QUEUE_SIZE;
+    memset(t, 0, sizeof(*t));
+    return t;
+}
+
+static uint32_t tft_trans_submit(spi_transaction_t *t) {
+    TFT_STATS_COUNT(transactions, 1);
+    TFT_STATS_COUNT(bytes, t->length / 8);
+    ESP_ERROR_CHECK(spi_device_queue_trans(spi, t, portMAX_DELAY));
+    return ++trans_queued;
+}
+
+static void tft_send_cmd(uint8_t cmd, const uint8_t *data, size_t len) {
+    spi_transaction_t *t = tft_trans_alloc();
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->length = 8;
+    t->user = TFT_DC_COMMAND;
+    t->tx_data[0] = cmd;
+    tft_trans_submit(t);
+
+    if (len == 0) {
+        return;
+    }
+
+    t = tft_trans_alloc();
+    t->length = len * 8;
+    t->user = TFT_DC_DATA;
+    if (len <= sizeof(t->tx_data)) {
+        // Short parameter blocks travel inside the transaction itself
+        t->flags = SPI_TRANS_USE_TXDATA;
+        memcpy(t->tx_data, data, len);
+    } else {
+        // Longer blocks must stay valid until the transfer completes
+        t->tx_buffer = data;
+    }
+    tft_trans_submit(t);
+}
+
+static uint32_t tft_send_pixels(const uint16_t *pixels, size_t count) {
+    spi_transaction_t *t = tft_trans_alloc();
+    t->length = count * 16;
+    t->user = TFT_DC_DATA;
+    t->tx_buffer = pixels;
+    return tft_trans_submit(t);
+}
+
+// Returns the next line buffer once the DMA engine has finished reading it
+static int tft_claim_line_buffer(void) {
+    int idx = dma_buf_next;
+    dma_buf_next = (dma_buf_next + 1) % TFT_DMA_BUF_COUNT;
+    tft_wait_seq(dma_buf_seq[idx]);
+    dma_buf_fill_len[idx] = 0;
+    return idx;
+}
+
+// Streams `count` pixels of one color into the current window. A buffer that
+// already holds enough of the color is requeued without being rewritten.
+static void tft_stream_fill(uint16_t color, uint32_t count) {
+    uint16_t px = TFT_SWAP16(color);
+    TFT_STATS_COUNT(pixels, count);
+
+    while (count > 0) {
+        uint32_t chunk = count > TFT_DMA_BUF_PIXELS ? TFT_DMA_BUF_PIXELS : count;
+        int idx = -1;
+
+        for (int i = 0; i < TFT_DMA_BUF_COUNT; i++) {
+            if (dma_buf_fill_len[i] >= chunk && dma_buf_fill_color[i] == px) {
+                idx = i;
+                break;
+            }
+        }
+
+        if (idx < 0) {
+            idx = tft_claim_line_buffer();
+            uint32_t fill = (count > chunk) ? TFT_DMA_BUF_PIXELS : chunk;
+            for (uint32_t i = 0; i < fill; i++) {
+                dma_buf[idx][i] = px;
+            }
+            dma_buf_fill_len[idx] = fill;
+            dma_buf_fill_color[idx] = px;
+        }
+
+        dma_buf_seq[idx] = tft_send_pixels(dma_buf[idx], chunk);
+        count -= chunk;
+    }
+}
+
+static void tft_send_cmd_list(const tft_cmd_t *cmds) {
+    for (; cmds->cmd != TFT_CMD_END; cmds++) {
+        tft_send_cmd(cmds->cmd, cmds->data, cmds->len);
+        if (cmds->delay_ms) {
+            tft_wait_done();
+            vTaskDelay(pdMS_TO_TICKS(cmds->delay_ms));
+        }
+    }
 }
 
 static void tft_set_address_window(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
-    tft_write_command(ST7789_CASET);
-    tft_write_data(x1 >> 8);
-    tft_write_data(x1 & 0xFF);
-    tft_write_data(x2 >> 8);
-    tft_write_data(x2 & 0xFF);
+    if (x1 != win_x1 || x2 != win_x2) {
+        uint8_t caset[4] = {x1 >> 8, x1 & 0xFF, x2 >> 8, x2 & 0xFF};
+        tft_send_cmd(ST7789_CASET, caset, sizeof(caset));
+        win_x1 = x1;
+        win_x2 = x2;
+    }
 
-    tft_write_command(ST7789_RASET);
-    tft_write_data(y1 >> 8);
-    tft_write_data(y1 & 0xFF);
-    tft_write_data(y2 >> 8);
-    tft_write_data(y2 & 0xFF);
+    if (y1 != win_y1 || y2 != win_y2) {
+        uint8_t raset[4] = {y1 >> 8, y1 & 0xFF, y2 >> 8, y2 & 0xFF};
+        tft_send_cmd(ST7789_RASET, raset, sizeof(raset));
+        win_y1 = y1;
+        win_y2 = y2;
+    }
 
-    tft_write_command(ST7789_RAMWR);
+    tft_send_cmd(ST7789_RAMWR, NULL, 0);
 }
 
 void tft_init_driver(void) {
@@ -109,172 +318,1778 @@ void tft_init_driver(void) {
         .clock_speed_hz = 40 * 1000 * 1000, // 40 MHz
         .mode = 0,
         .spics_io_num = TFT_CS,
-        .queue_size = 7,
+        .queue_size = TFT_QUEUE_SIZE,
         .flags = SPI_DEVICE_NO_DUMMY,
+        .pre_cb = tft_spi_pre_transfer_cb, // Drives DC for every transaction
     };
 
     // Attach the LCD to the SPI bus
     ESP_ERROR_CHECK(spi_bus_add_device(SPI2_HOST, &devcfg, &spi));
 
-    // Initialize ST7789
-    tft_write_command(ST7789_SWRESET);
-    vTaskDelay(pdMS_TO_TICKS(150));
+    // Allocate the DMA line buffers used for pixel streaming
+    for (int i = 0; i < TFT_DMA_BUF_COUNT; i++) {
+        dma_buf[i] = heap_caps_malloc(TFT_DMA_BUF_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA);
+        if (dma_buf[i] == NULL) {
+            ESP_LOGE(TAG, "Failed to allocate DMA line buffer %d", i);
+            abort();
+        }
+    }
+
+    // Initialize ST7789 (SWRESET also resets the panel's window registers)
+    win_x1 = win_x2 = win_y1 = win_y2 = 0xFFFF;
+    tft_send_cmd_list(st7789_init_cmds);
+    sleep_cmd_us = esp_timer_get_time() - 255 * 1000; // SLPOUT in the table
+
+    // Clear screen
+    tft_fill_screen(ST77XX_BLACK);
+
+    ESP_LOGI(TAG, "TFT Display Initialized Successfully");
+}
+
+// --- Pixel streaming API ---
+
+void tft_begin_write(int x, int y, int w, int h) {
+    TFT_STATS_SCOPE(TFT_PRIM_STREAM);
+    tft_frame_invalidate();
+    tft_set_address_window(x, y, x + w - 1, y + h - 1);
+}
 
-    tft_write_command(ST7789_SLPOUT);
-    vTaskDelay(pdMS_TO_TICKS(255));
+uint16_t *tft_get_line_buffer(void) {
+    return dma_buf[tft_claim_line_buffer()];
+}
 
-    // Memory Data Access Control
-    tft_write_command(ST7789_MADCTL);
-    tft_write_data(0x08); // RGB color filter panel
+void tft_queue_pixels(const uint16_t *pixels, size_t count) {
+    TFT_STATS_SCOPE(TFT_PRIM_STREAM);
+    TFT_STATS_COUNT(pixels, count);
+    uint32_t seq = tft_send_pixels(pixels, count);
 
-    // Interface Pixel Format
-    tft_write_command(0x3A);
-    tft_write_data(0x55); // 16 bits per pixel
+    for (int i = 0; i < TFT_DMA_BUF_COUNT; i++) {
+        if (pixels >= dma_buf[i] && pixels < dma_buf[i] + TFT_DMA_BUF_PIXELS) {
+            dma_buf_seq[i] = seq;
+        }
+    }
+}
 
-    // Display Inversion On
-    tft_write_command(ST7789_INVON);
-    vTaskDelay(pdMS_TO_TICKS(10));
+bool tft_is_busy(void) {
+    spi_transaction_t *done;
+    while (trans_done != trans_queued &&
+           spi_device_get_trans_result(spi, &done, 0) == ESP_OK) {
+        trans_done++;
+    }
+    return trans_done != trans_queued;
+}
 
-    // Normal Display Mode On
-    tft_write_command(0x13);
-    vTaskDelay(pdMS_TO_TICKS(10));
+void tft_wait_done(void) {
+    tft_wait_seq(trans_queued);
+}
 
-    // Display On
-    tft_write_command(ST7789_DISPON);
-    vTaskDelay(pdMS_TO_TICKS(100));
+// --- Framebuffer backend ---
+// In TFT_MODE_FRAMEBUFFER the primitives write into a RAM copy of the screen
+// (already in panel byte order) and record dirty rectangles. tft_flush() then
+// streams only those regions through the DMA line buffers.
+#define TFT_DIRTY_MAX         8
+#define TFT_DIRTY_MERGE_SLACK 1024 // Extra pixels worth sending to save a window
 
-    // Clear screen
-    tft_fill_screen(ST77XX_BLACK);
+typedef struct {
+    int x1, y1, x2, y2; // Inclusive
+} tft_rect_t;
 
-    ESP_LOGI(TAG, "TFT Display Initialized Successfully");
+static tft_render_mode_t render_mode = TFT_MODE_DIRECT;
+static uint16_t *framebuffer;
+static tft_rect_t dirty[TFT_DIRTY_MAX];
+static int dirty_count;
+
+static int rect_area(const tft_rect_t *r) {
+    return (r->x2 - r->x1 + 1) * (r->y2 - r->y1 + 1);
 }
 
-void tft_fill_screen(uint16_t color) {
-    tft_set_address_window(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
-    
-    gpio_set_level(TFT_DC, 1);
-    
-    // Send color data for entire screen
-    uint32_t size = TFT_WIDTH * TFT_HEIGHT;
-    spi_transaction_t t = {
-        .length = size * 16,
-        .tx_buffer = NULL,
+static tft_rect_t rect_union(const tft_rect_t *a, const tft_rect_t *b) {
+    tft_rect_t u = {
+        .x1 = a->x1 < b->x1 ? a->x1 : b->x1,
+        .y1 = a->y1 < b->y1 ? a->y1 : b->y1,
+        .x2 = a->x2 > b->x2 ? a->x2 : b->x2,
+        .y2 = a->y2 > b->y2 ? a->y2 : b->y2,
     };
-    
-    // Use a simple approach - send the same color repeatedly
-    uint16_t color_buffer[64]; // Small buffer
-    for (int i = 0; i < 64; i++) {
-        color_buffer[i] = color;
+    return u;
+}
+
+// Pixels a merge would send that neither rectangle needs
+static int rect_merge_cost(const tft_rect_t *a, const tft_rect_t *b) {
+    tft_rect_t u = rect_union(a, b);
+    return rect_area(&u) - rect_area(a) - rect_area(b);
+}
+
+// Adds r to a list of at most TFT_DIRTY_MAX rects, merging where cheap
+static void tft_rect_list_add(tft_rect_t *list, int *count, tft_rect_t r) {
+    // Absorb every existing rect that is cheap to merge with, then retry
+    // since the grown rect may now touch others.
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < *count; i++) {
+            if (rect_merge_cost(&r, &list[i]) <= TFT_DIRTY_MERGE_SLACK) {
+                r = rect_union(&r, &list[i]);
+                list[i] = list[--*count];
+                merged = true;
+                break;
+            }
+        }
     }
-    
-    t.tx_buffer = color_buffer;
-    t.length = 64 * 16;
-    
-    for (uint32_t i = 0; i < size; i += 64) {
-        uint32_t chunk_size = (size - i) > 64 ? 64 : (size - i);
-        if (chunk_size < 64) {
-            t.length = chunk_size * 16;
+
+    if (*count == TFT_DIRTY_MAX) {
+        // Out of slots: fold the new rect into the cheapest existing one
+        int best = 0;
+        for (int i = 1; i < *count; i++) {
+            if (rect_merge_cost(&r, &list[i]) < rect_merge_cost(&r, &list[best])) {
+                best = i;
+            }
         }
-        spi_device_polling_transmit(spi, &t);
+        list[best] = rect_union(&r, &list[best]);
+        return;
     }
+
+    list[(*count)++] = r;
 }
 
-void tft_draw_filled_rect(int x, int y, int w, int h, uint16_t color) {
-    if (x < 0 || y < 0 || x + w > TFT_WIDTH || y + h > TFT_HEIGHT) {
+static void tft_mark_dirty(int x, int y, int w, int h) {
+    tft_rect_list_add(dirty, &dirty_count, (tft_rect_t){x, y, x + w - 1, y + h - 1});
+}
+
+// --- Clipping ---
+// Primitives are trimmed to clip_rect, the intersection of every pushed clip
+// and the screen. Recorded draw calls keep the clip they were made under.
+#define TFT_CLIP_DEPTH 8
+
+static const tft_rect_t screen_rect = {0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1};
+static tft_rect_t clip_rect = {0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1};
+static tft_rect_t clip_stack[TFT_CLIP_DEPTH];
+static int clip_depth;
+static int clip_overflow; // Pushes beyond TFT_CLIP_DEPTH, ignored
+
+static tft_rect_t rect_intersect(const tft_rect_t *a, const tft_rect_t *b) {
+    tft_rect_t r = {
+        .x1 = a->x1 > b->x1 ? a->x1 : b->x1,
+        .y1 = a->y1 > b->y1 ? a->y1 : b->y1,
+        .x2 = a->x2 < b->x2 ? a->x2 : b->x2,
+        .y2 = a->y2 < b->y2 ? a->y2 : b->y2,
+    };
+    return r;
+}
+
+static bool rect_empty(const tft_rect_t *r) {
+    return r->x1 > r->x2 || r->y1 > r->y2;
+}
+
+static bool rect_equal(const tft_rect_t *a, const tft_rect_t *b) {
+    return a->x1 == b->x1 && a->y1 == b->y1 && a->x2 == b->x2 && a->y2 == b->y2;
+}
+
+void tft_push_clip(int x, int y, int w, int h) {
+    if (clip_depth == TFT_CLIP_DEPTH) {
+        ESP_LOGE(TAG, "Clip stack full, ignoring push");
+        clip_overflow++;
         return;
     }
+    tft_rect_t r = {x, y, x + w - 1, y + h - 1};
+    clip_stack[clip_depth++] = clip_rect;
+    clip_rect = rect_intersect(&clip_rect, &r);
+}
 
-    tft_set_address_window(x, y, x + w - 1, y + h - 1);
-    
-    gpio_set_level(TFT_DC, 1);
-    
-    uint32_t size = w * h;
-    spi_transaction_t t = {
-        .length = size * 16,
-        .tx_buffer = NULL,
-    };
-    
-    // Use a buffer for the color data
-    uint16_t color_buffer[32];
-    for (int i = 0; i < 32; i++) {
-        color_buffer[i] = color;
+void tft_pop_clip(void) {
+    if (clip_overflow > 0) {
+        clip_overflow--;
+    } else if (clip_depth > 0) {
+        clip_rect = clip_stack[--clip_depth];
     }
-    
-    t.tx_buffer = color_buffer;
-    t.length = 32 * 16;
-    
-    for (uint32_t i = 0; i < size; i += 32) {
-        uint32_t chunk_size = (size - i) > 32 ? 32 : (size - i);
-        if (chunk_size < 32) {
-            t.length = chunk_size * 16;
+}
+
+static void tft_fb_fill_rect(int x, int y, int w, int h, uint16_t color) {
+    uint16_t px = TFT_SWAP16(color);
+    TFT_STATS_COUNT(pixels, w * h);
+
+    for (int row = y; row < y + h; row++) {
+        uint16_t *dst = &framebuffer[row * TFT_WIDTH + x];
+        for (int i = 0; i < w; i++) {
+            dst[i] = px;
         }
-        spi_device_polling_transmit(spi, &t);
     }
+    tft_mark_dirty(x, y, w, h);
 }
 
-// Simple text drawing (basic implementation)
-void tft_draw_text(int x, int y, const char* text, int size, uint16_t color) {
-    // This is a basic implementation - draw simple blocks for text
-    int char_width = 6 * size;
-    int char_height = 8 * size;
-    
-    for (int i = 0; text[i] != '\0'; i++) {
-        // Draw a simple block for each character
-        tft_draw_filled_rect(x + i * char_width, y, char_width - 1, char_height, color);
+static void tft_fb_flush_rect(const tft_rect_t *r) {
+    int w = r->x2 - r->x1 + 1;
+    int rows_per_buf = TFT_DMA_BUF_PIXELS / w;
+
+    tft_set_address_window(r->x1, r->y1, r->x2, r->y2);
+
+    for (int y = r->y1; y <= r->y2; y += rows_per_buf) {
+        int rows = (r->y2 - y + 1) < rows_per_buf ? (r->y2 - y + 1) : rows_per_buf;
+        uint16_t *buf = tft_get_line_buffer();
+
+        for (int i = 0; i < rows; i++) {
+            memcpy(&buf[i * w], &framebuffer[(y + i) * TFT_WIDTH + r->x1], w * sizeof(uint16_t));
+        }
+        tft_queue_pixels(buf, rows * w);
     }
 }
 
-void tft_draw_rect(int x, int y, int w, int h, uint16_t color) {
-    // Draw horizontal lines
-    tft_draw_filled_rect(x, y, w, 1, color);
-    tft_draw_filled_rect(x, y + h - 1, w, 1, color);
-    
-    // Draw vertical lines
-    tft_draw_filled_rect(x, y, 1, h, color);
-    tft_draw_filled_rect(x + w - 1, y, 1, h, color);
+// --- Indexed framebuffer backend ---
+// TFT_MODE_INDEXED keeps the screen as 2-bit palette indices (19 KB instead
+// of 150 KB), four pixels per byte with the leftmost in the low bits. Colors
+// are mapped to the nearest palette entry when drawn, and expanded to RGB565
+// into the DMA line buffers when dirty regions are flushed, so changing what
+// an entry shows recolors the screen without redrawing: only the area that
+// uses the entry is resent.
+#define TFT_IX_COLORS 4
+#define TFT_IX_STRIDE (TFT_WIDTH / 4)
+
+static uint8_t *index_fb;
+static uint16_t ix_palette[TFT_IX_COLORS] = {ST77XX_BLACK, PB_DARK_GREEN, PB_GREEN, ST77XX_WHITE};
+static uint16_t ix_shown[TFT_IX_COLORS];     // Panel order, as sent
+static uint16_t ix_expand[256][4];           // Shown pixels for each index byte
+static uint16_t ix_last_color;
+static uint8_t ix_last_index;
+
+static void tft_ix_build_expand(void) {
+    for (int b = 0; b < 256; b++) {
+        for (int i = 0; i < 4; i++) {
+            ix_expand[b][i] = ix_shown[(b >> (i * 2)) & 3];
+        }
+    }
 }
 
-void tft_draw_line(int x0, int y0, int x1, int y1, uint16_t color) {
-    // Simple line drawing using filled rectangles
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
+// Marks the area holding pixels of one index, to the nearest 4 columns
+static void tft_ix_mark_index(uint8_t index) {
+    uint8_t pattern = index * 0x55;
+    tft_rect_t r = {TFT_IX_STRIDE, TFT_HEIGHT, -1, -1};
 
-    while (1) {
-        tft_draw_filled_rect(x0, y0, 1, 1, color);
-        
-        if (x0 == x1 && y0 == y1) break;
-        
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+    for (int y = 0; y < TFT_HEIGHT; y++) {
+        const uint8_t *line = &index_fb[y * TFT_IX_STRIDE];
+        for (int i = 0; i < TFT_IX_STRIDE; i++) {
+            uint8_t v = line[i] ^ pattern; // 2-bit field is 0 where the index matches
+            if (((v | (v >> 1)) & 0x55) != 0x55) {
+                if (i < r.x1) r.x1 = i;
+                if (i > r.x2) r.x2 = i;
+                if (r.y1 > y) r.y1 = y;
+                r.y2 = y;
+            }
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+    }
+
+    if (r.y2 >= 0) {
+        tft_mark_dirty(r.x1 * 4, r.y1, (r.x2 - r.x1 + 1) * 4, r.y2 - r.y1 + 1);
+    }
+}
+
+static void tft_ix_set_shown(int index, uint16_t color) {
+    ix_shown[index] = TFT_SWAP16(color);
+    tft_ix_build_expand();
+    if (render_mode == TFT_MODE_INDEXED) {
+        tft_ix_mark_index(index);
+    }
+}
+
+// Nearest palette entry by squared RGB565 channel distance
+static uint8_t tft_ix_color_index(uint16_t color) {
+    if (color == ix_last_color) {
+        return ix_last_index;
+    }
+
+    int best = 0;
+    int best_dist = INT32_MAX;
+    for (int i = 0; i < TFT_IX_COLORS; i++) {
+        int dr = (color >> 11) - (ix_palette[i] >> 11);
+        int dg = ((color >> 5) & 0x3F) - ((ix_palette[i] >> 5) & 0x3F);
+        int db = (color & 0x1F) - (ix_palette[i] & 0x1F);
+        int dist = dr * dr + dg * dg + db * db;
+        if (dist < best_dist) {
+            best = i;
+            best_dist = dist;
         }
     }
+
+    ix_last_color = color;
+    ix_last_index = best;
+    return best;
 }
 
-void tft_draw_h_line(int x, int y, int w, uint16_t color) {
-    tft_draw_filled_rect(x, y, w, 1, color);
+static inline void tft_ix_set(uint8_t *line, int x, uint8_t index) {
+    int shift = (x & 3) * 2;
+    line[x >> 2] = (line[x >> 2] & ~(3 << shift)) | (index << shift);
 }
 
-void tft_draw_circle(int x, int y, int r, uint16_t color) {
-    // Simple circle drawing using filled rectangles
-    for (int i = -r; i <= r; i++) {
-        for (int j = -r; j <= r; j++) {
-            if (i*i + j*j <= r*r) {
-                tft_draw_filled_rect(x + i, y + j, 1, 1, color);
+static void tft_ix_fill_rect(int x, int y, int w, int h, uint16_t color) {
+    uint8_t index = tft_ix_color_index(color);
+    int end = x + w;
+    TFT_STATS_COUNT(pixels, w * h);
+
+    for (int row = y; row < y + h; row++) {
+        uint8_t *line = &index_fb[row * TFT_IX_STRIDE];
+        int px = x;
+
+        for (; px < end && (px & 3); px++) {
+            tft_ix_set(line, px, index);
+        }
+        if (end - px >= 4) {
+            memset(&line[px >> 2], index * 0x55, (end - px) >> 2);
+            px += (end - px) & ~3;
+        }
+        for (; px < end; px++) {
+            tft_ix_set(line, px, index);
+        }
+    }
+    tft_mark_dirty(x, y, w, h);
+}
+
+static void tft_ix_flush_rect(const tft_rect_t *r) {
+    int w = r->x2 - r->x1 + 1;
+    int rows_per_buf = TFT_DMA_BUF_PIXELS / w;
+
+    tft_set_address_window(r->x1, r->y1, r->x2, r->y2);
+
+    for (int y = r->y1; y <= r->y2; y += rows_per_buf) {
+        int rows = (r->y2 - y + 1) < rows_per_buf ? (r->y2 - y + 1) : rows_per_buf;
+        uint16_t *buf = tft_get_line_buffer();
+        uint16_t *dst = buf;
+
+        for (int i = 0; i < rows; i++) {
+            const uint8_t *line = &index_fb[(y + i) * TFT_IX_STRIDE];
+            int x = r->x1;
+
+            for (; x <= r->x2 && (x & 3); x++) {
+                *dst++ = ix_shown[(line[x >> 2] >> ((x & 3) * 2)) & 3];
+            }
+            // Whole bytes expand four pixels at a time
+            for (; x + 3 <= r->x2; x += 4, dst += 4) {
+                memcpy(dst, ix_expand[line[x >> 2]], sizeof(ix_expand[0]));
+            }
+            for (; x <= r->x2; x++) {
+                *dst++ = ix_shown[(line[x >> 2] >> ((x & 3) * 2)) & 3];
             }
         }
+        tft_queue_pixels(buf, rows * w);
     }
 }
 
-int tft_get_text_width(const char* text, int size) {
-    // Simple estimation - 6 pixels per character * size
-    return strlen(text) * 6 * size;
-}
\ No newline at end of file
+void tft_set_palette(const uint16_t *colors, int count) {
+    if (count < 1) {
+        ESP_LOGE(TAG, "Empty palette, ignoring");
+        return;
+    }
+    if (count > TFT_IX_COLORS) {
+        ESP_LOGW(TAG, "Palette of %d colors, using the first %d", count, TFT_IX_COLORS);
+        count = TFT_IX_COLORS;
+    }
+    for (int i = 0; i < TFT_IX_COLORS; i++) {
+        ix_palette[i] = i < count ? colors[i] : colors[count - 1];
+        ix_shown[i] = TFT_SWAP16(ix_palette[i]);
+    }
+    ix_last_color = ix_palette[0];
+    ix_last_index = 0;
+    tft_ix_build_expand();
+    if (render_mode == TFT_MODE_INDEXED) {
+        tft_mark_dirty(0, 0, TFT_WIDTH, TFT_HEIGHT);
+    }
+}
+
+void tft_remap_color(uint16_t color, uint16_t shown) {
+    tft_ix_set_shown(tft_ix_color_index(color), shown);
+}
+
+// --- Band renderer ---
+// In TFT_MODE_BAND the public draw calls are recorded into a display list.
+// tft_flush() sends the area the list draws through windows built from the
+// rects of its commands, so pixels outside every command are left alone on
+// the panel; inside a command's rect, pixels it doesn't draw (around a line,
+// behind transparent text) are painted with the background color (black).
+// Each window is rendered band by band into a DMA line buffer, replaying the
+// list clipped to that band, and streamed through one address window while
+// the next band renders into the other buffer.
+#define TFT_BAND_MAX_CMDS  320
+#define TFT_BAND_TEXT_POOL 1024
+#define TFT_FRAME_MAX_CMDS  512 // A retained frame can't be flushed early
+#define TFT_FRAME_TEXT_POOL 1024
+
+typedef enum {
+    TFT_OP_FILL,
+    TFT_OP_TEXT,
+    TFT_OP_TEXT_BG,
+    TFT_OP_LINE,
+    TFT_OP_CIRCLE,
+    TFT_OP_IMAGE,
+    TFT_OP_REGION,
+} tft_op_t;
+
+#define TFT_LIST_MAX_CLIPS 8 // Distinct clip rects per display list, [0] = screen
+
+typedef struct {
+    uint8_t op;
+    uint8_t size;      // Text scale
+    uint16_t color;
+    int16_t a, b, c, d; // FILL/IMAGE/REGION: x,y,w,h  LINE: x0,y0,x1,y1  CIRCLE: x,y,r,r_inner  TEXT: x,y,bg
+    uint16_t text;     // Offset into the list's text pool
+    uint8_t clip;      // Index into the list's clip rects
+    union {
+        const tft_font_t *font;
+        const tft_image_t *image;
+        const tft_region_t *region;
+    };
+} tft_band_cmd_t;
+
+typedef struct {
+    tft_band_cmd_t *cmds;
+    char *text;
+    int max_cmds;
+    int text_size;
+    int cmd_count;
+    int text_len;
+    tft_rect_t clips[TFT_LIST_MAX_CLIPS];
+    int clip_count;
+} tft_display_list_t;
+
+static void tft_draw_annulus(int x, int y, int r, int r_inner, uint16_t color);
+
+static tft_band_cmd_t band_cmds[TFT_BAND_MAX_CMDS];
+static char band_text[TFT_BAND_TEXT_POOL];
+static tft_display_list_t band_list = {
+    band_cmds, band_text, TFT_BAND_MAX_CMDS, TFT_BAND_TEXT_POOL,
+    .clips = {{0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1}}, .clip_count = 1,
+};
+static bool band_replaying;
+
+// Target of the replay currently in progress
+static uint16_t *band_buf;
+static tft_rect_t band_clip;
+
+// Retained frames (see tft_frame_begin())
+static tft_display_list_t frame_lists[2]; // Current and previous frame, allocated on first use
+static bool frame_enabled;
+static int frame_cur;
+static bool frame_recording;
+static bool frame_full_repaint;
+static tft_rect_t frame_stale[TFT_DIRTY_MAX]; // Drawn outside frames since the last one
+static int frame_stale_count;
+
+// Area a command can touch, within `clip`
+static tft_rect_t tft_band_cmd_bounds(const tft_band_cmd_t *cmd, const char *text, const tft_rect_t *clip) {
+    tft_rect_t r;
+    switch (cmd->op) {
+        case TFT_OP_FILL:
+        case TFT_OP_IMAGE:
+        case TFT_OP_REGION:
+            r = (tft_rect_t){cmd->a, cmd->b, cmd->a + cmd->c - 1, cmd->b + cmd->d - 1};
+            break;
+        case TFT_OP_TEXT:
+        case TFT_OP_TEXT_BG:
+            r = (tft_rect_t){cmd->a, cmd->b,
+                             cmd->a + tft_font_text_width(cmd->font, text) * cmd->size - 1,
+                             cmd->b + cmd->font->height * cmd->size - 1};
+            break;
+        case TFT_OP_LINE:
+            r = (tft_rect_t){cmd->a < cmd->c ? cmd->a : cmd->c, cmd->b < cmd->d ? cmd->b : cmd->d,
+                             cmd->a > cmd->c ? cmd->a : cmd->c, cmd->b > cmd->d ? cmd->b : cmd->d};
+            break;
+        default: // TFT_OP_CIRCLE
+            r = (tft_rect_t){cmd->a - cmd->c, cmd->b - cmd->c, cmd->a + cmd->c, cmd->b + cmd->c};
+            break;
+    }
+
+    // Only the visible part matters for band selection
+    return rect_intersect(&r, clip);
+}
+
+static tft_rect_t tft_list_cmd_bounds(const tft_display_list_t *list, const tft_band_cmd_t *cmd) {
+    return tft_band_cmd_bounds(cmd, &list->text[cmd->text], &list->clips[cmd->clip]);
+}
+
+static void tft_list_clear(tft_display_list_t *list) {
+    list->cmd_count = 0;
+    list->text_len = 0;
+    list->clips[0] = screen_rect;
+    list->clip_count = 1;
+}
+
+// Index of the current clip rect in the list, adding it if new (-1 when full)
+static int tft_list_clip_index(tft_display_list_t *list) {
+    for (int i = list->clip_count - 1; i >= 0; i--) {
+        if (rect_equal(&list->clips[i], &clip_rect)) {
+            return i;
+        }
+    }
+    if (list->clip_count == TFT_LIST_MAX_CLIPS) {
+        return -1;
+    }
+    list->clips[list->clip_count] = clip_rect;
+    return list->clip_count++;
+}
+
+static void tft_band_replay(const tft_display_list_t *list, const tft_band_cmd_t *cmd) {
+    const tft_font_t *saved_font = font;
+
+    switch (cmd->op) {
+        case TFT_OP_FILL:
+            tft_draw_filled_rect(cmd->a, cmd->b, cmd->c, cmd->d, cmd->color);
+            break;
+        case TFT_OP_TEXT:
+            font = cmd->font;
+            tft_draw_text(cmd->a, cmd->b, &list->text[cmd->text], cmd->size, cmd->color);
+            break;
+        case TFT_OP_TEXT_BG:
+            font = cmd->font;
+            tft_draw_text_bg(cmd->a, cmd->b, &list->text[cmd->text], cmd->size, cmd->color, (uint16_t)cmd->c);
+            break;
+        case TFT_OP_LINE:
+            tft_draw_line(cmd->a, cmd->b, cmd->c, cmd->d, cmd->color);
+            break;
+        case TFT_OP_CIRCLE:
+            tft_draw_annulus(cmd->a, cmd->b, cmd->c, cmd->d, cmd->color);
+            break;
+        case TFT_OP_IMAGE:
+            tft_draw_image(cmd->a, cmd->b, cmd->image);
+            break;
+        case TFT_OP_REGION:
+            tft_draw_region(cmd->a, cmd->b, cmd->c, cmd->d, cmd->region);
+            break;
+    }
+    font = saved_font;
+}
+
+// Sends a rendered band to the panel, or into the RAM copy in the
+// framebuffer modes (retained frames render through bands in every mode).
+// The bands of `win` follow each other through one address window.
+static void tft_band_output(const tft_rect_t *band, const tft_rect_t *win) {
+    int w = band->x2 - band->x1 + 1;
+    int h = band->y2 - band->y1 + 1;
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER) {
+        for (int row = 0; row < h; row++) {
+            memcpy(&framebuffer[(band->y1 + row) * TFT_WIDTH + band->x1], &band_buf[row * w], w * sizeof(uint16_t));
+        }
+        tft_mark_dirty(band->x1, band->y1, w, h);
+    } else if (render_mode == TFT_MODE_INDEXED) {
+        const uint16_t *src = band_buf;
+        for (int row = band->y1; row <= band->y2; row++) {
+            uint8_t *line = &index_fb[row * TFT_IX_STRIDE];
+            for (int x = band->x1; x <= band->x2; x++) {
+                uint16_t px = *src++;
+                tft_ix_set(line, x, tft_ix_color_index(TFT_SWAP16(px)));
+            }
+        }
+        tft_mark_dirty(band->x1, band->y1, w, h);
+    } else {
+        if (band->y1 == win->y1) {
+            tft_set_address_window(win->x1, win->y1, win->x2, win->y2);
+        }
+        tft_queue_pixels(band_buf, w * h);
+    }
+}
+
+// True when a and b together cover their bounding box
+static bool rect_union_exact(const tft_rect_t *a, const tft_rect_t *b) {
+    if ((a->x1 <= b->x1 && a->x2 >= b->x2 && a->y1 <= b->y1 && a->y2 >= b->y2) ||
+        (b->x1 <= a->x1 && b->x2 >= a->x2 && b->y1 <= a->y1 && b->y2 >= a->y2)) {
+        return true; // One contains the other
+    }
+    if (a->y1 == b->y1 && a->y2 == b->y2) {
+        return a->x1 <= b->x2 + 1 && b->x1 <= a->x2 + 1;
+    }
+    if (a->x1 == b->x1 && a->x2 == b->x2) {
+        return a->y1 <= b->y2 + 1 && b->y1 <= a->y2 + 1;
+    }
+    return false;
+}
+
+// Windows covering exactly the commands' rects within `area`: each rect is
+// merged with the others only where the pair still covers its bounding box.
+// Windows may overlap; the overlap is rendered the same in both.
+static int tft_band_windows(const tft_display_list_t *list, const tft_rect_t *bounds,
+                            const tft_rect_t *area, tft_rect_t *windows) {
+    int count = 0;
+    for (int i = 0; i < list->cmd_count; i++) {
+        tft_rect_t r = rect_intersect(&bounds[i], area);
+        if (rect_empty(&r)) {
+            continue;
+        }
+
+        // Absorb every window it merges with exactly, then retry with the grown rect
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (int j = 0; j < count; j++) {
+                if (rect_union_exact(&r, &windows[j])) {
+                    r = rect_union(&r, &windows[j]);
+                    windows[j] = windows[--count];
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        windows[count++] = r;
+    }
+    return count;
+}
+
+// Replays the commands that reach `win` one band at a time. Narrow windows
+// get taller bands so every buffer is used in full.
+static void tft_band_render_window(const tft_display_list_t *list, const tft_rect_t *bounds,
+                                   const tft_rect_t *win) {
+    int w = win->x2 - win->x1 + 1;
+    int rows_per_band = TFT_DMA_BUF_PIXELS / w;
+
+    for (int y = win->y1; y <= win->y2; y += rows_per_band) {
+        tft_rect_t band = {win->x1, y, win->x2, y + rows_per_band - 1};
+        if (band.y2 > win->y2) band.y2 = win->y2;
+
+        band_buf = tft_get_line_buffer();
+        band_clip = band;
+        memset(band_buf, 0, w * (band.y2 - band.y1 + 1) * sizeof(uint16_t));
+
+        for (int i = 0; i < list->cmd_count; i++) {
+            if (bounds[i].y1 <= band.y2 && bounds[i].y2 >= band.y1 &&
+                bounds[i].x1 <= band.x2 && bounds[i].x2 >= band.x1) {
+                clip_rect = list->clips[list->cmds[i].clip];
+                tft_band_replay(list, &list->cmds[i]);
+            }
+        }
+
+        tft_band_output(&band, win);
+    }
+}
+
+// Replays `list` over `area`. With `shrink` only where commands reach it
+// (see tft_band_windows()); otherwise the whole area is repainted,
+// background included.
+static void tft_band_render(const tft_display_list_t *list, const tft_rect_t *bounds,
+                            const tft_rect_t *area, bool shrink) {
+    static tft_rect_t windows[TFT_BAND_MAX_CMDS]; // Too large for task stacks
+    tft_rect_t saved_clip = clip_rect;
+
+    band_replaying = true;
+    if (shrink) {
+        int count = tft_band_windows(list, bounds, area, windows);
+        for (int i = 0; i < count; i++) {
+            tft_band_render_window(list, bounds, &windows[i]);
+        }
+    } else {
+        tft_band_render_window(list, bounds, area);
+    }
+    band_replaying = false;
+    clip_rect = saved_clip;
+}
+
+static void tft_band_flush(void) {
+    static tft_rect_t bounds[TFT_BAND_MAX_CMDS]; // Too large for task stacks
+    tft_rect_t area = {TFT_WIDTH, TFT_HEIGHT, -1, -1};
+
+    for (int i = 0; i < band_list.cmd_count; i++) {
+        bounds[i] = tft_list_cmd_bounds(&band_list, &band_list.cmds[i]);
+        if (rect_empty(&bounds[i])) {
+            continue;
+        }
+        area = (area.x2 < 0) ? bounds[i] : rect_union(&area, &bounds[i]);
+    }
+
+    if (area.x2 >= 0) {
+        tft_band_render(&band_list, bounds, &area, true);
+    }
+
+    tft_list_clear(&band_list);
+}
+
+// List that draw calls are currently captured into, if any
+static tft_display_list_t *tft_band_target(void) {
+    if (band_replaying) {
+        return NULL;
+    }
+    if (frame_recording) {
+        return &frame_lists[frame_cur];
+    }
+    return render_mode == TFT_MODE_BAND ? &band_list : NULL;
+}
+
+// Returns true when the call was captured for later replay
+static bool tft_band_record_cmd(const tft_band_cmd_t *cmd, const char *text) {
+    tft_display_list_t *list = tft_band_target();
+
+    if (!band_replaying) {
+        tft_rect_t r = tft_band_cmd_bounds(cmd, text, &clip_rect);
+        if (rect_empty(&r)) {
+            return true; // Entirely clipped: nothing to draw or record
+        }
+        if (frame_enabled && !frame_recording) {
+            // Drawn outside a frame: the retained picture is out of date there
+            tft_rect_list_add(frame_stale, &frame_stale_count, r);
+        }
+    }
+    if (list == NULL) {
+        return false;
+    }
+
+    int text_len = text ? (int)strlen(text) + 1 : 0;
+    int clip = tft_list_clip_index(list);
+    if (clip < 0 || list->cmd_count == list->max_cmds || list->text_len + text_len > list->text_size) {
+        if (list != &band_list) {
+            // A frame can't be split: drop the call and repaint in full next time
+            ESP_LOGW(TAG, "Retained frame full, dropping draw call");
+            frame_full_repaint = true;
+            return true;
+        }
+        // List is full: render what we have and start a new one
+        tft_band_flush();
+        if (text_len > TFT_BAND_TEXT_POOL) {
+            return true;
+        }
+        clip = tft_list_clip_index(list);
+    }
+
+    tft_band_cmd_t *dst = &list->cmds[list->cmd_count++];
+    *dst = *cmd;
+    dst->clip = clip;
+    if (text) {
+        dst->text = list->text_len;
+        memcpy(&list->text[list->text_len], text, text_len);
+        list->text_len += text_len;
+    }
+    return true;
+}
+
+static bool tft_band_record(tft_op_t op, int a, int b, int c, int d, uint16_t color,
+                            const char *text, int size) {
+    tft_band_cmd_t cmd = {
+        .op = op, .size = size, .color = color,
+        .a = a, .b = b, .c = c, .d = d,
+        .font = font,
+    };
+    return tft_band_record_cmd(&cmd, text);
+}
+
+static void tft_band_fill_rect(int x, int y, int w, int h, uint16_t color) {
+    int x1 = x > band_clip.x1 ? x : band_clip.x1;
+    int y1 = y > band_clip.y1 ? y : band_clip.y1;
+    int x2 = (x + w - 1) < band_clip.x2 ? (x + w - 1) : band_clip.x2;
+    int y2 = (y + h - 1) < band_clip.y2 ? (y + h - 1) : band_clip.y2;
+    int stride = band_clip.x2 - band_clip.x1 + 1;
+    uint16_t px = TFT_SWAP16(color);
+
+    if (x2 >= x1 && y2 >= y1) {
+        TFT_STATS_COUNT(pixels, (x2 - x1 + 1) * (y2 - y1 + 1));
+    }
+
+    for (int row = y1; row <= y2; row++) {
+        uint16_t *dst = &band_buf[(row - band_clip.y1) * stride - band_clip.x1];
+        for (int col = x1; col <= x2; col++) {
+            dst[col] = px;
+        }
+    }
+}
+
+esp_err_t tft_set_render_mode(tft_render_mode_t mode) {
+    if (mode == render_mode) {
+        return ESP_OK;
+    }
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER) {
+        tft_flush();
+        tft_wait_done();
+        heap_caps_free(framebuffer);
+        framebuffer = NULL;
+    } else if (render_mode == TFT_MODE_INDEXED) {
+        tft_flush();
+        tft_wait_done();
+        heap_caps_free(index_fb);
+        index_fb = NULL;
+    } else if (render_mode == TFT_MODE_BAND) {
+        tft_flush();
+    }
+
+    if (mode == TFT_MODE_INDEXED) {
+        // Small enough for internal RAM, which also keeps the expansion fast
+        size_t size = TFT_IX_STRIDE * TFT_HEIGHT;
+        index_fb = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        if (index_fb == NULL) {
+            ESP_LOGE(TAG, "Not enough memory for a %d byte indexed framebuffer", (int)size);
+            render_mode = TFT_MODE_DIRECT;
+            return ESP_ERR_NO_MEM;
+        }
+
+        tft_set_palette(ix_palette, TFT_IX_COLORS);
+        memset(index_fb, tft_ix_color_index(ST77XX_BLACK) * 0x55, size);
+        dirty_count = 0;
+        tft_mark_dirty(0, 0, TFT_WIDTH, TFT_HEIGHT);
+    }
+
+    if (mode == TFT_MODE_FRAMEBUFFER) {
+        size_t size = TFT_WIDTH * TFT_HEIGHT * sizeof(uint16_t);
+#if CONFIG_SPIRAM
+        framebuffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+#endif
+        if (framebuffer == NULL) {
+            framebuffer = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+        }
+        if (framebuffer == NULL) {
+            ESP_LOGE(TAG, "Not enough memory for a %d byte framebuffer", (int)size);
+            render_mode = TFT_MODE_DIRECT;
+            return ESP_ERR_NO_MEM;
+        }
+
+        // Start from a black frame and push it once so RAM and panel agree
+        memset(framebuffer, 0, size);
+        dirty_count = 0;
+        tft_mark_dirty(0, 0, TFT_WIDTH, TFT_HEIGHT);
+    }
+
+    if (mode == TFT_MODE_BAND) {
+        tft_list_clear(&band_list);
+    }
+
+    // The new backend starts from a black screen
+    frame_full_repaint = true;
+
+    static const char *mode_names[] = {"direct", "framebuffer", "band", "indexed"};
+    render_mode = mode;
+    ESP_LOGI(TAG, "Render mode: %s", mode_names[mode]);
+    return ESP_OK;
+}
+
+tft_render_mode_t tft_get_render_mode(void) {
+    return render_mode;
+}
+
+static void tft_flush_backend(void) {
+    TFT_STATS_SCOPE(TFT_PRIM_FLUSH);
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER) {
+        for (int i = 0; i < dirty_count; i++) {
+            tft_fb_flush_rect(&dirty[i]);
+        }
+        dirty_count = 0;
+    } else if (render_mode == TFT_MODE_INDEXED) {
+        for (int i = 0; i < dirty_count; i++) {
+            tft_ix_flush_rect(&dirty[i]);
+        }
+        dirty_count = 0;
+    } else if (render_mode == TFT_MODE_BAND) {
+        tft_band_flush();
+    }
+}
+
+// A flush also closes the current stats frame
+void tft_flush(void) {
+    tft_flush_backend();
+    tft_stats_frame_mark();
+}
+
+// --- Retained frames ---
+// Two display lists alternate between frames. tft_frame_end() pairs each
+// command with an identical one from the previous frame; the bounds of the
+// unpaired ones (added, changed or removed) plus whatever was drawn outside
+// frames since then are the damage. Each damaged rect is re-rendered from
+// the new list through the band renderer, so only those pixels are resent.
+// Reordering identical commands alone is not seen as a change.
+
+static bool tft_band_cmd_equal(const tft_display_list_t *la, const tft_band_cmd_t *a,
+                               const tft_display_list_t *lb, const tft_band_cmd_t *b) {
+    if (a->op != b->op || a->a != b->a || a->b != b->b || a->c != b->c || a->d != b->d ||
+        a->color != b->color || !rect_equal(&la->clips[a->clip], &lb->clips[b->clip])) {
+        return false;
+    }
+    if (a->op == TFT_OP_TEXT || a->op == TFT_OP_TEXT_BG) {
+        return a->size == b->size && a->font == b->font &&
+               strcmp(&la->text[a->text], &lb->text[b->text]) == 0;
+    }
+    if (a->op == TFT_OP_REGION) {
+        return false; // Its pixels may differ behind the same source
+    }
+    return a->op != TFT_OP_IMAGE || a->image == b->image;
+}
+
+void tft_frame_begin(void) {
+    if (!frame_enabled) {
+        for (int i = 0; i < 2; i++) {
+            tft_display_list_t *list = &frame_lists[i];
+            list->cmds = heap_caps_malloc(TFT_FRAME_MAX_CMDS * sizeof(tft_band_cmd_t), MALLOC_CAP_8BIT);
+            list->text = heap_caps_malloc(TFT_FRAME_TEXT_POOL, MALLOC_CAP_8BIT);
+            list->max_cmds = TFT_FRAME_MAX_CMDS;
+            list->text_size = TFT_FRAME_TEXT_POOL;
+            tft_list_clear(list);
+            if (list->cmds == NULL || list->text == NULL) {
+                ESP_LOGE(TAG, "Not enough memory for retained frames, drawing immediately");
+                for (int j = 0; j <= i; j++) {
+                    heap_caps_free(frame_lists[j].cmds);
+                    heap_caps_free(frame_lists[j].text);
+                }
+                return;
+            }
+        }
+        frame_enabled = true;
+        frame_full_repaint = true;
+    }
+
+    // Calls recorded before the frame go out first
+    if (render_mode == TFT_MODE_BAND) {
+        tft_band_flush();
+    }
+
+    tft_list_clear(&frame_lists[frame_cur]);
+    frame_recording = true;
+}
+
+static void tft_frame_render_changes(void) {
+    TFT_STATS_SCOPE(TFT_PRIM_FLUSH);
+    static tft_rect_t bounds[TFT_FRAME_MAX_CMDS];
+    static bool prev_used[TFT_FRAME_MAX_CMDS];
+    const tft_display_list_t *cur = &frame_lists[frame_cur];
+    const tft_display_list_t *prev = &frame_lists[frame_cur ^ 1];
+    tft_rect_t damage[TFT_DIRTY_MAX];
+    int damage_count = 0;
+
+    if (frame_full_repaint) {
+        damage[damage_count++] = (tft_rect_t){0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1};
+    } else {
+        memcpy(damage, frame_stale, sizeof(damage));
+        damage_count = frame_stale_count;
+    }
+    memset(prev_used, 0, sizeof(prev_used));
+
+    for (int i = 0; i < cur->cmd_count; i++) {
+        const tft_band_cmd_t *cmd = &cur->cmds[i];
+        bounds[i] = tft_list_cmd_bounds(cur, cmd);
+        if (frame_full_repaint || rect_empty(&bounds[i])) {
+            continue;
+        }
+
+        bool found = false;
+        for (int j = 0; j < prev->cmd_count && !found; j++) {
+            if (!prev_used[j] && tft_band_cmd_equal(cur, cmd, prev, &prev->cmds[j])) {
+                prev_used[j] = true;
+                found = true;
+            }
+        }
+        if (!found) {
+            tft_rect_list_add(damage, &damage_count, bounds[i]);
+        }
+    }
+
+    for (int j = 0; j < prev->cmd_count && !frame_full_repaint; j++) {
+        if (!prev_used[j]) {
+            tft_rect_t r = tft_list_cmd_bounds(prev, &prev->cmds[j]);
+            if (!rect_empty(&r)) {
+                tft_rect_list_add(damage, &damage_count, r);
+            }
+        }
+    }
+
+    for (int i = 0; i < damage_count; i++) {
+        tft_band_render(cur, bounds, &damage[i], false);
+    }
+}
+
+void tft_frame_end(void) {
+    if (frame_recording) {
+        frame_recording = false;
+        tft_frame_render_changes();
+        frame_full_repaint = false;
+        frame_stale_count = 0;
+        frame_cur ^= 1;
+    }
+    tft_flush();
+}
+
+void tft_frame_invalidate(void) {
+    frame_full_repaint = true;
+}
+
+bool tft_frame_is_recording(void) {
+    return frame_recording;
+}
+
+void tft_fill_screen(uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_FILL_SCREEN);
+
+    if (!rect_equal(&clip_rect, &screen_rect)) {
+        tft_draw_filled_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, color);
+        return;
+    }
+
+    tft_display_list_t *list = tft_band_target();
+    if (list) {
+        // Everything recorded so far would be painted over
+        tft_list_clear(list);
+    }
+    if (tft_band_record(TFT_OP_FILL, 0, 0, TFT_WIDTH, TFT_HEIGHT, color, NULL, 0)) {
+        return;
+    }
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER) {
+        dirty_count = 0;
+        tft_fb_fill_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, color);
+        return;
+    }
+
+    if (render_mode == TFT_MODE_INDEXED) {
+        dirty_count = 0;
+        tft_ix_fill_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, color);
+        return;
+    }
+
+    tft_set_address_window(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
+    tft_stream_fill(color, TFT_WIDTH * TFT_HEIGHT);
+}
+
+void tft_draw_filled_rect(int x, int y, int w, int h, uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_FILL_RECT);
+
+    if (tft_band_record(TFT_OP_FILL, x, y, w, h, color, NULL, 0)) {
+        return;
+    }
+
+    // Trim to the clip rect; every other primitive ends up here
+    tft_rect_t r = {x, y, x + w - 1, y + h - 1};
+    r = rect_intersect(&r, &clip_rect);
+    if (rect_empty(&r)) {
+        return;
+    }
+    x = r.x1;
+    y = r.y1;
+    w = r.x2 - r.x1 + 1;
+    h = r.y2 - r.y1 + 1;
+
+    if (band_replaying) {
+        tft_band_fill_rect(x, y, w, h, color);
+        return;
+    }
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER) {
+        tft_fb_fill_rect(x, y, w, h, color);
+        return;
+    }
+
+    if (render_mode == TFT_MODE_INDEXED) {
+        tft_ix_fill_rect(x, y, w, h, color);
+        return;
+    }
+
+    tft_set_address_window(x, y, x + w - 1, y + h - 1);
+    tft_stream_fill(color, (uint32_t)w * h);
+}
+
+// --- Text ---
+
+void tft_set_font(const tft_font_t *new_font) {
+    font = new_font;
+}
+
+const tft_font_t *tft_get_font(void) {
+    return font;
+}
+
+// Transparent text: lit pixels of each glyph row are merged into horizontal
+// runs across the whole string, one filled span per run.
+void tft_draw_text(int x, int y, const char* text, int size, uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_TEXT);
+
+    if (tft_band_record(TFT_OP_TEXT, x, y, 0, 0, color, text, size)) {
+        return;
+    }
+
+    tft_glyph_t glyph;
+
+    for (int row = 0; row < font->height; row++) {
+        int run_start = -1;
+        int cx = x;
+
+        for (const char *p = text; *p; p++) {
+            tft_font_glyph(font, *p, &glyph);
+            for (int col = 0; col < glyph.advance; col++) {
+                bool lit = col < glyph.width && ((glyph.cols[col] >> row) & 1);
+                int px = cx + col * size;
+                if (lit && run_start < 0) {
+                    run_start = px;
+                } else if (!lit && run_start >= 0) {
+                    tft_draw_filled_rect(run_start, y + row * size, px - run_start, size, color);
+                    run_start = -1;
+                }
+            }
+            cx += glyph.advance * size;
+        }
+
+        if (run_start >= 0) {
+            tft_draw_filled_rect(run_start, y + row * size, cx - run_start, size, color);
+        }
+    }
+}
+
+// Opaque text: the whole string is rasterized into one address window and
+// streamed through the DMA line buffers.
+void tft_draw_text_bg(int x, int y, const char* text, int size, uint16_t color, uint16_t bg) {
+    TFT_STATS_SCOPE(TFT_PRIM_TEXT_BG);
+
+    int w = tft_get_text_width(text, size);
+    int h = font->height * size;
+
+    if (w == 0 || tft_band_record(TFT_OP_TEXT_BG, x, y, bg, 0, color, text, size)) {
+        return;
+    }
+
+    if (render_mode != TFT_MODE_DIRECT || band_replaying || x < clip_rect.x1 || y < clip_rect.y1 ||
+        x + w - 1 > clip_rect.x2 || y + h - 1 > clip_rect.y2) {
+        // Buffered backends draw into RAM anyway; clipped text is drawn as trimmed spans
+        tft_draw_filled_rect(x, y, w, h, bg);
+        tft_draw_text(x, y, text, size, color);
+        return;
+    }
+
+    uint16_t fg_px = TFT_SWAP16(color);
+    uint16_t bg_px = TFT_SWAP16(bg);
+    int rows_per_buf = TFT_DMA_BUF_PIXELS / w;
+    tft_glyph_t glyph;
+
+    tft_set_address_window(x, y, x + w - 1, y + h - 1);
+    TFT_STATS_COUNT(pixels, w * h);
+
+    for (int y0 = 0; y0 < h; y0 += rows_per_buf) {
+        int rows = (h - y0) < rows_per_buf ? (h - y0) : rows_per_buf;
+        uint16_t *buf = tft_get_line_buffer();
+
+        for (int r = 0; r < rows; r++) {
+            uint16_t *dst = &buf[r * w];
+
+            // Scaled rows repeat the row above
+            if (r > 0 && (y0 + r) % size != 0) {
+                memcpy(dst, dst - w, w * sizeof(uint16_t));
+                continue;
+            }
+
+            int bit = (y0 + r) / size;
+            for (const char *p = text; *p; p++) {
+                tft_font_glyph(font, *p, &glyph);
+                for (int col = 0; col < glyph.advance; col++) {
+                    bool lit = col < glyph.width && ((glyph.cols[col] >> bit) & 1);
+                    uint16_t px = lit ? fg_px : bg_px;
+                    for (int s = 0; s < size; s++) {
+                        *dst++ = px;
+                    }
+                }
+            }
+        }
+        tft_queue_pixels(buf, rows * w);
+    }
+}
+
+void tft_draw_rect(int x, int y, int w, int h, uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_RECT);
+
+    // Draw horizontal lines
+    tft_draw_filled_rect(x, y, w, 1, color);
+    tft_draw_filled_rect(x, y + h - 1, w, 1, color);
+    
+    // Draw vertical lines
+    tft_draw_filled_rect(x, y, 1, h, color);
+    tft_draw_filled_rect(x + w - 1, y, 1, h, color);
+}
+
+// --- Lines ---
+
+#define CLIP_LEFT   1
+#define CLIP_RIGHT  2
+#define CLIP_TOP    4
+#define CLIP_BOTTOM 8
+
+static int tft_clip_code(int x, int y) {
+    int code = 0;
+    if (x < clip_rect.x1) code |= CLIP_LEFT;
+    else if (x > clip_rect.x2) code |= CLIP_RIGHT;
+    if (y < clip_rect.y1) code |= CLIP_TOP;
+    else if (y > clip_rect.y2) code |= CLIP_BOTTOM;
+    return code;
+}
+
+// Bresenham that emits each horizontal (x-major) or vertical (y-major) run of
+// pixels as a single span instead of one 1x1 rect per pixel. The endpoints
+// are never moved to the clip edge: the spans are trimmed instead, so a
+// clipped line lights exactly the pixels the unclipped one would.
+void tft_draw_line(int x0, int y0, int x1, int y1, uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_LINE);
+
+    if (tft_band_record(TFT_OP_LINE, x0, y0, x1, y1, color, NULL, 0)) {
+        return;
+    }
+
+    // Both ends beyond the same clip edge: nothing is visible
+    if (tft_clip_code(x0, y0) & tft_clip_code(x1, y1)) {
+        return;
+    }
+
+    // Axis-aligned fast paths
+    if (y0 == y1) {
+        tft_draw_filled_rect(x0 < x1 ? x0 : x1, y0, abs(x1 - x0) + 1, 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        tft_draw_filled_rect(x0, y0 < y1 ? y0 : y1, 1, abs(y1 - y0) + 1, color);
+        return;
+    }
+
+    int dx = abs(x1 - x0);
+    int dy = -abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy;
+    bool x_major = dx >= -dy;
+
+    int run_x = x0, run_y = y0, run_len = 1;
+
+    while (x0 != x1 || y0 != y1) {
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+
+        if (x_major ? (y0 == run_y) : (x0 == run_x)) {
+            run_len++;
+            continue;
+        }
+
+        if (x_major) {
+            tft_draw_filled_rect(sx > 0 ? run_x : run_x - run_len + 1, run_y, run_len, 1, color);
+        } else {
+            tft_draw_filled_rect(run_x, sy > 0 ? run_y : run_y - run_len + 1, 1, run_len, color);
+        }
+        run_x = x0;
+        run_y = y0;
+        run_len = 1;
+    }
+
+    if (x_major) {
+        tft_draw_filled_rect(sx > 0 ? run_x : run_x - run_len + 1, run_y, run_len, 1, color);
+    } else {
+        tft_draw_filled_rect(run_x, sy > 0 ? run_y : run_y - run_len + 1, 1, run_len, color);
+    }
+}
+
+void tft_draw_h_line(int x, int y, int w, uint16_t color) {
+    tft_draw_filled_rect(x, y, w, 1, color);
+}
+
+// --- Circles ---
+
+// Half-width of a midpoint disc of radius r at row offset dy (pixel centres
+// within r + 1/2), refined from the previous row's value.
+static int tft_disc_half_width(int r, int dy, int x) {
+    int lim = r * r + r - dy * dy;
+    if (x < 0) x = 0;
+    while (x > 0 && x * x > lim) x--;
+    while ((x + 1) * (x + 1) <= lim) x++;
+    return x;
+}
+
+static void tft_emit_annulus_rows(int cx, int y, int h, int xo, int xi, uint16_t color) {
+    if (xi < 0) {
+        tft_draw_filled_rect(cx - xo, y, 2 * xo + 1, h, color);
+    } else {
+        tft_draw_filled_rect(cx - xo, y, xo - xi, h, color);
+        tft_draw_filled_rect(cx + xi + 1, y, xo - xi, h, color);
+    }
+}
+
+// Everything between radius r_inner (exclusive) and r, one or two spans per
+// scanline. Consecutive rows with identical spans are merged into one rect,
+// so the near-vertical sides of an outline cost a handful of writes.
+// r_inner < 0 draws a filled disc.
+static void tft_draw_annulus(int x, int y, int r, int r_inner, uint16_t color) {
+    TFT_STATS_SCOPE(TFT_PRIM_CIRCLE);
+
+    if (tft_band_record(TFT_OP_CIRCLE, x, y, r, r_inner, color, NULL, 0)) {
+        return;
+    }
+    if (r < 0) {
+        return;
+    }
+
+    int run_y = y - r, run_xo = -1, run_xi = -1;
+    int xo = 0, xi = 0;
+
+    for (int dy = -r; dy <= r; dy++) {
+        int ady = abs(dy);
+        int row_xi = -1;
+
+        xo = tft_disc_half_width(r, ady, xo);
+        if (r_inner >= 0 && ady <= r_inner) {
+            xi = tft_disc_half_width(r_inner, ady, xi);
+            row_xi = (xi < xo) ? xi : xo - 1; // Keep rings at least 1 px thick
+        }
+
+        if (xo == run_xo && row_xi == run_xi) {
+            continue;
+        }
+        if (run_xo >= 0) {
+            tft_emit_annulus_rows(x, run_y, y + dy - run_y, run_xo, run_xi, color);
+        }
+        run_y = y + dy;
+        run_xo = xo;
+        run_xi = row_xi;
+    }
+    tft_emit_annulus_rows(x, run_y, y + r + 1 - run_y, run_xo, run_xi, color);
+}
+
+void tft_draw_circle(int x, int y, int r, uint16_t color) {
+    tft_draw_annulus(x, y, r, r - 1, color);
+}
+
+void tft_fill_circle(int x, int y, int r, uint16_t color) {
+    tft_draw_annulus(x, y, r, -1, color);
+}
+
+void tft_draw_ring(int x, int y, int r_outer, int r_inner, uint16_t color) {
+    tft_draw_annulus(x, y, r_outer, r_inner, color);
+}
+
+int tft_get_text_width(const char* text, int size) {
+    return tft_font_text_width(font, text) * size;
+}
+
+// --- Images ---
+
+// Decodes the visible part of the image row by row. Rows are written straight
+// into the render target (framebuffer, band or line buffers), so the direct
+// path sends the whole image through one address window.
+void tft_draw_image(int x, int y, const tft_image_t *img) {
+    TFT_STATS_SCOPE(TFT_PRIM_IMAGE);
+
+    tft_band_cmd_t cmd = {
+        .op = TFT_OP_IMAGE,
+        .a = x, .b = y, .c = img->width, .d = img->height,
+        .image = img,
+    };
+    if (tft_band_record_cmd(&cmd, NULL)) {
+        return;
+    }
+
+    tft_rect_t clip = band_replaying ? rect_intersect(&clip_rect, &band_clip) : clip_rect;
+    int x1 = x > clip.x1 ? x : clip.x1;
+    int y1 = y > clip.y1 ? y : clip.y1;
+    int x2 = (x + img->width - 1) < clip.x2 ? (x + img->width - 1) : clip.x2;
+    int y2 = (y + img->height - 1) < clip.y2 ? (y + img->height - 1) : clip.y2;
+    if (x2 < x1 || y2 < y1) {
+        return;
+    }
+
+    int w = x2 - x1 + 1;
+    int h = y2 - y1 + 1;
+    int skip_left = x1 - x;
+    int skip_right = img->width - w - skip_left;
+    tft_image_decoder_t dec;
+    tft_image_decoder_init(&dec, img);
+    tft_image_decode(&dec, NULL, (uint32_t)(y1 - y) * img->width);
+
+    if (render_mode == TFT_MODE_INDEXED && !band_replaying) {
+        // Decode palette indices instead of colors
+        static uint16_t row_buf[TFT_WIDTH];
+        for (int i = 0; i < img->palette_size; i++) {
+            dec.palette[i] = tft_ix_color_index(img->palette[i]);
+        }
+        TFT_STATS_COUNT(pixels, w * h);
+
+        for (int row = y1; row <= y2; row++) {
+            uint8_t *line = &index_fb[row * TFT_IX_STRIDE];
+            tft_image_decode(&dec, NULL, skip_left);
+            tft_image_decode(&dec, row_buf, w);
+            tft_image_decode(&dec, NULL, skip_right);
+            for (int i = 0; i < w; i++) {
+                tft_ix_set(line, x1 + i, row_buf[i]);
+            }
+        }
+        tft_mark_dirty(x1, y1, w, h);
+        return;
+    }
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER || band_replaying) {
+        int stride = band_replaying ? band_clip.x2 - band_clip.x1 + 1 : TFT_WIDTH;
+        uint16_t *dst = band_replaying
+            ? &band_buf[(y1 - band_clip.y1) * stride + (x1 - band_clip.x1)]
+            : &framebuffer[y1 * TFT_WIDTH + x1];
+        TFT_STATS_COUNT(pixels, w * h);
+
+        for (int row = 0; row < h; row++, dst += stride) {
+            tft_image_decode(&dec, NULL, skip_left);
+            tft_image_decode(&dec, dst, w);
+            tft_image_decode(&dec, NULL, skip_right);
+        }
+        if (!band_replaying) {
+            tft_mark_dirty(x1, y1, w, h);
+        }
+        return;
+    }
+
+    int rows_per_buf = TFT_DMA_BUF_PIXELS / w;
+    tft_set_address_window(x1, y1, x2, y2);
+
+    for (int row = 0; row < h; row += rows_per_buf) {
+        int rows = (h - row) < rows_per_buf ? (h - row) : rows_per_buf;
+        uint16_t *buf = tft_get_line_buffer();
+
+        for (int i = 0; i < rows; i++) {
+            tft_image_decode(&dec, NULL, skip_left);
+            tft_image_decode(&dec, &buf[i * w], w);
+            tft_image_decode(&dec, NULL, skip_right);
+        }
+        tft_queue_pixels(buf, rows * w);
+    }
+}
+
+// --- Pixel regions ---
+
+// Same targets as images, with rows from the source instead of the decoder
+void tft_draw_region(int x, int y, int w, int h, const tft_region_t *src) {
+    TFT_STATS_SCOPE(TFT_PRIM_REGION);
+
+    tft_band_cmd_t cmd = {
+        .op = TFT_OP_REGION,
+        .a = x, .b = y, .c = w, .d = h,
+        .region = src,
+    };
+    if (tft_band_record_cmd(&cmd, NULL)) {
+        return;
+    }
+
+    tft_rect_t clip = band_replaying ? rect_intersect(&clip_rect, &band_clip) : clip_rect;
+    int x1 = x > clip.x1 ? x : clip.x1;
+    int y1 = y > clip.y1 ? y : clip.y1;
+    int x2 = (x + w - 1) < clip.x2 ? (x + w - 1) : clip.x2;
+    int y2 = (y + h - 1) < clip.y2 ? (y + h - 1) : clip.y2;
+    if (x2 < x1 || y2 < y1) {
+        return;
+    }
+    w = x2 - x1 + 1;
+    h = y2 - y1 + 1;
+
+    if (render_mode == TFT_MODE_INDEXED && !band_replaying) {
+        static uint16_t row_buf[TFT_WIDTH];
+        TFT_STATS_COUNT(pixels, w * h);
+
+        for (int row = y1; row <= y2; row++) {
+            uint8_t *line = &index_fb[row * TFT_IX_STRIDE];
+            src->fill_row(src, x1, row, w, row_buf);
+            for (int i = 0; i < w; i++) {
+                tft_ix_set(line, x1 + i, tft_ix_color_index(TFT_SWAP16(row_buf[i])));
+            }
+        }
+        tft_mark_dirty(x1, y1, w, h);
+        return;
+    }
+
+    if (render_mode == TFT_MODE_FRAMEBUFFER || band_replaying) {
+        int stride = band_replaying ? band_clip.x2 - band_clip.x1 + 1 : TFT_WIDTH;
+        uint16_t *dst = band_replaying
+            ? &band_buf[(y1 - band_clip.y1) * stride + (x1 - band_clip.x1)]
+            : &framebuffer[y1 * TFT_WIDTH + x1];
+        TFT_STATS_COUNT(pixels, w * h);
+
+        for (int row = y1; row <= y2; row++, dst += stride) {
+            src->fill_row(src, x1, row, w, dst);
+        }
+        if (!band_replaying) {
+            tft_mark_dirty(x1, y1, w, h);
+        }
+        return;
+    }
+
+    int rows_per_buf = TFT_DMA_BUF_PIXELS / w;
+    tft_set_address_window(x1, y1, x2, y2);
+
+    for (int row = y1; row <= y2; row += rows_per_buf) {
+        int rows = (y2 - row + 1) < rows_per_buf ? (y2 - row + 1) : rows_per_buf;
+        uint16_t *buf = tft_get_line_buffer();
+
+        for (int i = 0; i < rows; i++) {
+            src->fill_row(src, x1, row + i, w, &buf[i * w]);
+        }
+        tft_queue_pixels(buf, rows * w);
+    }
+}
+
+// --- Hardware scrolling ---
+// The panel's frame memory has TFT_RAM_ROWS rows, of which the first
+// TFT_HEIGHT are visible. With the MADCTL used here panel rows are display
+// rows, so VSCRDEF/VSCSAD scroll vertically. Rows past the visible ones are
+// put in the bottom fixed area so the ring only holds on-screen rows.
+#define TFT_RAM_ROWS 320
+
+static int scroll_top;
+static int scroll_height; // 0 = scrolling disabled
+static int scroll_offset;
+
+void tft_scroll_define(int top, int height) {
+    if (top < 0) top = 0;
+    if (top > TFT_HEIGHT - 1) top = TFT_HEIGHT - 1;
+    if (height < 1 || height > TFT_HEIGHT - top) height = TFT_HEIGHT - top;
+
+    // Parameters longer than tx_data are sent by reference
+    static uint8_t vscrdef[6];
+    int bottom = TFT_RAM_ROWS - top - height;
+    vscrdef[0] = top >> 8;
+    vscrdef[1] = top & 0xFF;
+    vscrdef[2] = height >> 8;
+    vscrdef[3] = height & 0xFF;
+    vscrdef[4] = bottom >> 8;
+    vscrdef[5] = bottom & 0xFF;
+
+    tft_flush_backend();
+    tft_send_cmd(ST7789_VSCRDEF, vscrdef, sizeof(vscrdef));
+    tft_wait_done();
+
+    scroll_top = top;
+    scroll_height = height;
+    scroll_offset = -1;
+    tft_scroll_to(0);
+}
+
+void tft_scroll_to(int offset) {
+    if (scroll_height == 0) {
+        return;
+    }
+    offset %= scroll_height;
+    if (offset < 0) offset += scroll_height;
+    if (offset == scroll_offset) {
+        return;
+    }
+
+    // Pending buffered drawing targets the rows as they are now
+    tft_flush_backend();
+
+    uint16_t start = scroll_top + offset;
+    uint8_t vscsad[2] = {start >> 8, start & 0xFF};
+    tft_send_cmd(ST7789_VSCSAD, vscsad, sizeof(vscsad));
+    scroll_offset = offset;
+    tft_frame_invalidate();
+}
+
+int tft_scroll_get(void) {
+    return scroll_height ? scroll_offset : 0;
+}
+
+int tft_scroll_row(int y) {
+    if (scroll_height == 0 || y < scroll_top || y >= scroll_top + scroll_height) {
+        return y;
+    }
+    return scroll_top + (y - scroll_top + scroll_offset) % scroll_height;
+}
+
+// Fills `n` scroll-area rows starting at display row `y`, following the wrap
+static void tft_scroll_fill_rows(int y, int n, uint16_t color) {
+    int ram = tft_scroll_row(y);
+    int first = scroll_top + scroll_height - ram;
+    if (first > n) first = n;
+
+    tft_draw_filled_rect(0, ram, TFT_WIDTH, first, color);
+    if (n > first) {
+        tft_draw_filled_rect(0, scroll_top, TFT_WIDTH, n - first, color);
+    }
+}
+
+void tft_scroll_smooth(int rows, int step, int frame_ms, uint16_t fill) {
+    if (scroll_height == 0 || step < 1) {
+        return;
+    }
+
+    int dir = rows < 0 ? -1 : 1;
+    int total = rows * dir;
+    for (int done = 0; done < total; done += step) {
+        int n = total - done < step ? total - done : step;
+
+        // Clear the rows that leave the area; they wrap in on the other side
+        int y = dir > 0 ? scroll_top : scroll_top + scroll_height - n;
+        tft_scroll_fill_rows(y, n, fill);
+        tft_scroll_to(scroll_offset + dir * n);
+        if (frame_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(frame_ms));
+        }
+    }
+    tft_flush_backend();
+}
+
+void tft_scroll_reset(void) {
+    static const uint8_t vscrdef_full[6] = {0, 0, TFT_RAM_ROWS >> 8, TFT_RAM_ROWS & 0xFF, 0, 0};
+    uint8_t vscsad[2] = {0, 0};
+
+    if (scroll_height == 0) {
+        return;
+    }
+
+    tft_flush_backend();
+    tft_send_cmd(ST7789_VSCRDEF, vscrdef_full, sizeof(vscrdef_full));
+    tft_send_cmd(ST7789_VSCSAD, vscsad, sizeof(vscsad));
+    tft_send_cmd(ST7789_NORON, NULL, 0); // Leaves vertical scroll mode
+    partial_mode = false;
+    scroll_height = 0;
+    scroll_offset = 0;
+    tft_frame_invalidate();
+}
+
+// --- Power modes ---
+// Sleep in/out must be 120 ms apart and the panel takes 5 ms after either
+// before it accepts the next command. Panel RAM survives sleep, so waking only
+// needs SLPOUT.
+#define TFT_SLEEP_SETTLE_MS 120
+#define TFT_SLEEP_CMD_MS    5
+
+static bool asleep;
+static bool idle_mode;
+
+static void tft_delay_until(int64_t t_us) {
+    int64_t wait_us = t_us - esp_timer_get_time();
+    if (wait_us > 0) {
+        vTaskDelay(pdMS_TO_TICKS((wait_us + 999) / 1000) + 1);
+    }
+}
+
+static void tft_send_sleep_cmd(uint8_t cmd) {
+    tft_flush_backend();
+    tft_delay_until(sleep_cmd_us + TFT_SLEEP_SETTLE_MS * 1000);
+    tft_send_cmd(cmd, NULL, 0);
+    tft_wait_done();
+    sleep_cmd_us = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(TFT_SLEEP_CMD_MS) + 1);
+}
+
+void tft_sleep(void) {
+    if (!asleep) {
+        tft_send_sleep_cmd(ST7789_SLPIN);
+        asleep = true;
+    }
+}
+
+void tft_wake(void) {
+    if (asleep) {
+        tft_send_sleep_cmd(ST7789_SLPOUT);
+        asleep = false;
+    }
+}
+
+bool tft_is_asleep(void) {
+    return asleep;
+}
+
+void tft_set_idle_mode(bool on) {
+    if (on != idle_mode) {
+        tft_flush_backend();
+        tft_send_cmd(on ? ST7789_IDMON : ST7789_IDMOFF, NULL, 0);
+        idle_mode = on;
+    }
+}
+
+void tft_set_partial_area(int y1, int y2) {
+    tft_flush_backend();
+
+    if (y1 < 0 || y1 > y2) {
+        if (partial_mode) {
+            tft_send_cmd(ST7789_NORON, NULL, 0);
+            partial_mode = false;
+            scroll_height = 0;
+        }
+        return;
+    }
+
+    if (y2 > TFT_HEIGHT - 1) y2 = TFT_HEIGHT - 1;
+    uint8_t ptlar[4] = {y1 >> 8, y1 & 0xFF, y2 >> 8, y2 & 0xFF};
+    tft_send_cmd(ST7789_PTLAR, ptlar, sizeof(ptlar));
+    if (!partial_mode) {
+        tft_send_cmd(ST7789_PTLON, NULL, 0);
+        partial_mode = true;
+    }
+}
+
+// --- Tearing effect ---
+void tft_set_tearing_output(bool on) {
+    static const uint8_t te_vblank_only = 0x00; // TEM = 0: one pulse per frame
+
+    if (on) {
+        tft_send_cmd(ST7789_TEON, &te_vblank_only, 1);
+    } else {
+        tft_send_cmd(ST7789_TEOFF, NULL, 0);
+    }
+}
+
+// --- Instrumentation API ---
+
+static const char *prim_names[TFT_PRIM_COUNT] = {
+    [TFT_PRIM_FILL_SCREEN] = "fill_screen",
+    [TFT_PRIM_FILL_RECT]   = "fill_rect",
+    [TFT_PRIM_RECT]        = "rect",
+    [TFT_PRIM_LINE]        = "line",
+    [TFT_PRIM_CIRCLE]      = "circle",
+    [TFT_PRIM_TEXT]        = "text",
+    [TFT_PRIM_TEXT_BG]     = "text_bg",
+    [TFT_PRIM_IMAGE]       = "image",
+    [TFT_PRIM_REGION]      = "region",
+    [TFT_PRIM_FLUSH]       = "flush",
+    [TFT_PRIM_STREAM]      = "stream",
+    [TFT_PRIM_OTHER]       = "other",
+};
+
+const char *tft_prim_name(tft_prim_t prim) {
+    return prim < TFT_PRIM_COUNT ? prim_names[prim] : "?";
+}
+
+#if CONFIG_TFT_STATS
+static void tft_stats_accumulate(tft_stats_t *dst, const tft_stats_t *src) {
+    for (int i = 0; i < TFT_PRIM_COUNT; i++) {
+        dst->prim[i].calls += src->prim[i].calls;
+        dst->prim[i].transactions += src->prim[i].transactions;
+        dst->prim[i].pixels += src->prim[i].pixels;
+        dst->prim[i].bytes += src->prim[i].bytes;
+        dst->prim[i].time_us += src->prim[i].time_us;
+    }
+    dst->frames += src->frames;
+}
+#endif
+
+void tft_stats_frame_mark(void) {
+#if CONFIG_TFT_STATS
+    stats_frame.frames = 1;
+    tft_stats_accumulate(&stats_total, &stats_frame);
+    stats_last_frame = stats_frame;
+    memset(&stats_frame, 0, sizeof(stats_frame));
+#endif
+}
+
+void tft_stats_get(tft_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+#if CONFIG_TFT_STATS
+    *out = stats_total;
+    tft_stats_accumulate(out, &stats_frame);
+#endif
+}
+
+void tft_stats_get_frame(tft_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+#if CONFIG_TFT_STATS
+    *out = stats_last_frame;
+#endif
+}
+
+void tft_stats_reset(void) {
+#if CONFIG_TFT_STATS
+    memset(&stats_total, 0, sizeof(stats_total));
+    memset(&stats_frame, 0, sizeof(stats_frame));
+    memset(&stats_last_frame, 0, sizeof(stats_last_frame));
+#endif
+}
+
+void tft_stats_log(const tft_stats_t *stats) {
+    ESP_LOGI(TAG, "%-11s %7s %7s %9s %9s %9s", "primitive", "calls", "trans", "pixels", "bytes", "us");
+    for (int i = 0; i < TFT_PRIM_COUNT; i++) {
+        const tft_prim_stats_t *p = &stats->prim[i];
+        if (p->calls == 0 && p->transactions == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "%-11s %7u %7u %9u %9u %9lld", prim_names[i],
+                 (unsigned)p->calls, (unsigned)p->transactions, (unsigned)p->pixels,
+                 (unsigned)p->bytes, (long long)p->time_us);
+    }
+}
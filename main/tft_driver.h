@@ -2,8 +2,13 @@
 #define TFT_DRIVER_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#include "tft_font.h"
+#include "tft_image.h"
 
 // Display dimensions
 #define TFT_WIDTH  320
@@ -15,15 +20,164 @@
 #define ST77XX_BLACK   0x0000
 #define ST77XX_WHITE   0xFFFF
 
+// The panel expects RGB565 big-endian; pixels in line buffers must be swapped
+#define TFT_SWAP16(c)  ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+// DMA line buffers: two of these are streamed ping-pong style
+#ifndef CONFIG_TFT_DMA_BUF_LINES
+#define CONFIG_TFT_DMA_BUF_LINES 12
+#endif
+#define TFT_DMA_BUF_PIXELS (TFT_WIDTH * CONFIG_TFT_DMA_BUF_LINES)
+
+// Rendering backends
+typedef enum {
+    TFT_MODE_DIRECT,      // Primitives are written straight to the panel
+    TFT_MODE_FRAMEBUFFER, // Primitives draw into RAM; tft_flush() sends dirty regions
+    TFT_MODE_BAND,        // Draw calls are recorded; tft_flush() renders them strip by strip
+    TFT_MODE_INDEXED,     // Like FRAMEBUFFER, but 2 bits per pixel through a 4-color palette
+} tft_render_mode_t;
+
+// Primitive categories used by the draw statistics
+typedef enum {
+    TFT_PRIM_FILL_SCREEN,
+    TFT_PRIM_FILL_RECT,
+    TFT_PRIM_RECT,
+    TFT_PRIM_LINE,
+    TFT_PRIM_CIRCLE,
+    TFT_PRIM_TEXT,
+    TFT_PRIM_TEXT_BG,
+    TFT_PRIM_IMAGE,
+    TFT_PRIM_REGION,
+    TFT_PRIM_FLUSH,
+    TFT_PRIM_STREAM,
+    TFT_PRIM_OTHER,   // Commands issued outside any primitive
+    TFT_PRIM_COUNT
+} tft_prim_t;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t transactions;
+    uint32_t pixels;
+    uint32_t bytes;
+    int64_t time_us;
+} tft_prim_stats_t;
+
+typedef struct {
+    tft_prim_stats_t prim[TFT_PRIM_COUNT];
+    uint32_t frames;
+} tft_stats_t;
+
+// Pixel source for tft_draw_region(): writes the w pixels of row y from x on,
+// in panel byte order (TFT_SWAP16). Embed it as the first member of the
+// source's state so fill_row can get back to it.
+typedef struct tft_region tft_region_t;
+struct tft_region {
+    void (*fill_row)(const tft_region_t *src, int x, int y, int w, uint16_t *dst);
+};
+
 // Function prototypes
 void tft_init_driver(void);
 void tft_fill_screen(uint16_t color);
 void tft_draw_text(int x, int y, const char* text, int size, uint16_t color);
+void tft_draw_text_bg(int x, int y, const char* text, int size, uint16_t color, uint16_t bg);
 void tft_draw_rect(int x, int y, int w, int h, uint16_t color);
 void tft_draw_line(int x0, int y0, int x1, int y1, uint16_t color);
 void tft_draw_h_line(int x, int y, int w, uint16_t color);
-void tft_draw_circle(int x, int y, int r, uint16_t color);
+void tft_draw_circle(int x, int y, int r, uint16_t color);                   // 1 px outline
+void tft_fill_circle(int x, int y, int r, uint16_t color);                   // Solid disc
+void tft_draw_ring(int x, int y, int r_outer, int r_inner, uint16_t color);  // Annulus
 void tft_draw_filled_rect(int x, int y, int w, int h, uint16_t color);
+void tft_draw_image(int x, int y, const tft_image_t *img);
+// Like an image whose pixels come from src when the call is rendered: right
+// away, or at the next tft_flush() in band mode, so src must stay valid
+// until then. Retained frames always see it as changed.
+void tft_draw_region(int x, int y, int w, int h, const tft_region_t *src);
 int tft_get_text_width(const char* text, int size);
+void tft_set_font(const tft_font_t *font);
+const tft_font_t *tft_get_font(void);
+
+// Clipping. Every primitive is trimmed to the current clip rect, which starts
+// as the whole screen; tft_push_clip() narrows it to its intersection with
+// the given rect until the matching tft_pop_clip() (up to 8 levels). Calls
+// entirely outside the clip return without doing any work. Pixel streaming
+// ignores it.
+void tft_push_clip(int x, int y, int w, int h);
+void tft_pop_clip(void);
+
+// Backend selection. In buffered modes nothing reaches the panel until
+// tft_flush(); in direct mode tft_flush() is a no-op.
+esp_err_t tft_set_render_mode(tft_render_mode_t mode);
+tft_render_mode_t tft_get_render_mode(void);
+void tft_flush(void);
+
+// Indexed mode palette. Drawn colors map to the nearest of the 4 entries
+// (default: black, PB_DARK_GREEN, PB_GREEN, white). count is 1..4: fewer
+// colors repeat the last one, more are ignored, and an empty palette is
+// rejected with the current one kept. tft_remap_color() changes
+// only how the entry for `color` is shown: the area using it is resent in
+// the new color on the next flush without redrawing, e.g. for fades.
+void tft_set_palette(const uint16_t *colors, int count);
+void tft_remap_color(uint16_t color, uint16_t shown);
+
+// Retained frames. Draw calls between tft_frame_begin() and tft_frame_end()
+// are recorded instead of drawn; tft_frame_end() compares them with the
+// previous frame and re-renders only the areas whose calls changed (on black,
+// like the band renderer), then flushes. Drawing outside frames is tracked,
+// so those areas are repainted by the next frame; scrolling and streamed
+// pixels make it repaint in full, as does tft_frame_invalidate().
+void tft_frame_begin(void);
+void tft_frame_end(void);
+void tft_frame_invalidate(void);
+// Between tft_frame_begin() and tft_frame_end(): pixels can't be streamed
+bool tft_frame_is_recording(void);
+
+// Pixel streaming (always targets the panel): open a window, then fill line buffers and queue them.
+// tft_get_line_buffer() blocks only until that buffer's previous transfer is
+// done, so the CPU can render the next lines while the last ones are sent.
+void tft_begin_write(int x, int y, int w, int h);
+uint16_t *tft_get_line_buffer(void);
+void tft_queue_pixels(const uint16_t *pixels, size_t count);
+bool tft_is_busy(void);
+void tft_wait_done(void);
+
+// Hardware vertical scrolling. Display rows [top, top + height) become a ring
+// whose first visible row is panel row top + offset. Drawing keeps using panel
+// rows, so map display rows with tft_scroll_row() while scrolling is active.
+// tft_scroll_smooth() moves the content by `rows` (up if positive) in steps,
+// filling the rows that wrap around; use it for page transitions.
+// After tft_scroll_reset() the panel shows rows unscrolled again, so the
+// caller redraws the area.
+void tft_scroll_define(int top, int height);
+void tft_scroll_to(int offset);
+int tft_scroll_get(void);
+int tft_scroll_row(int y);
+void tft_scroll_smooth(int rows, int step, int frame_ms, uint16_t fill);
+void tft_scroll_reset(void);
+
+// Power modes. Idle mode shows 8 colours (each channel reduced to its top
+// bit, so PB_DARK_GREEN goes black); partial mode only drives rows y1..y2 and
+// turns the rest off (y1 < 0 returns to normal mode, which also ends
+// scrolling). Sleep turns the panel off but keeps its RAM, so tft_wake()
+// restores the picture without reinitialising; both calls honour the
+// panel's 120 ms sleep in/out spacing. Drawing while asleep is allowed.
+void tft_set_idle_mode(bool on);
+void tft_set_partial_area(int y1, int y2);
+void tft_sleep(void);
+void tft_wake(void);
+bool tft_is_asleep(void);
+
+// Tearing-effect output. With it on, the panel's TE pin pulses at the start
+// of every vertical blanking period (about 60 Hz); see tft_sched.h.
+void tft_set_tearing_output(bool on);
+
+// Draw statistics. Counters are only collected with CONFIG_TFT_STATS; without
+// it the calls below return zeros and the primitives carry no overhead.
+// tft_flush() closes a frame; tft_stats_get_frame() returns the last one.
+void tft_stats_frame_mark(void);
+void tft_stats_get(tft_stats_t *out);
+void tft_stats_get_frame(tft_stats_t *out);
+void tft_stats_reset(void);
+void tft_stats_log(const tft_stats_t *stats);
+const char *tft_prim_name(tft_prim_t prim);
 
 #endif
\ No newline at end of file
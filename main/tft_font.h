@@ -0,0 +1,35 @@
+#ifndef TFT_FONT_H
+#define TFT_FONT_H
+
+#include <stdint.h>
+
+// 1bpp bitmap font. Glyphs are stored column by column, one byte per column,
+// bit 0 being the top row.
+typedef struct {
+    const uint8_t *bitmap;   // glyph_cols bytes per glyph
+    const uint8_t *metrics;  // Proportional fonts: (first column << 4) | width; NULL if monospace
+    uint8_t first_char;
+    uint8_t last_char;
+    uint8_t glyph_cols;      // Columns stored per glyph
+    uint8_t height;          // Cell height in pixels
+    uint8_t advance;         // Cell width of monospace fonts
+    uint8_t spacing;         // Gap after each proportional glyph
+} tft_font_t;
+
+typedef struct {
+    const uint8_t *cols;     // First inked column of the glyph
+    uint8_t width;           // Inked columns to draw
+    uint8_t advance;         // Horizontal distance to the next glyph
+} tft_glyph_t;
+
+// Built-in fonts (same 5x7 glyph set)
+extern const tft_font_t tft_font_6x8;  // Monospace, 6 px advance
+extern const tft_font_t tft_font_prop; // Proportional, 1 px between glyphs
+
+// Looks up a character; unknown characters map to '?'
+void tft_font_glyph(const tft_font_t *font, char c, tft_glyph_t *glyph);
+
+// Width of a string in font pixels (unscaled), including the trailing gap
+int tft_font_text_width(const tft_font_t *font, const char *text);
+
+#endif // TFT_FONT_H
@@ -0,0 +1,59 @@
+#include <stddef.h>
+#include "tft_image.h"
+#include "tft_driver.h"
+
+void tft_image_decoder_init(tft_image_decoder_t *dec, const tft_image_t *img) {
+    dec->pos = img->data;
+    dec->end = img->data + img->data_size;
+    dec->run = 0;
+    for (int i = 0; i < TFT_IMAGE_MAX_COLORS; i++) {
+        uint16_t c = i < img->palette_size ? img->palette[i] : 0;
+        dec->palette[i] = TFT_SWAP16(c);
+    }
+    dec->color = dec->palette[0];
+}
+
+// Loads the next run header
+static void tft_image_next_run(tft_image_decoder_t *dec) {
+    if (dec->pos >= dec->end) {
+        dec->color = dec->palette[0];
+        dec->run = UINT32_MAX;
+        return;
+    }
+
+    uint8_t b = *dec->pos++;
+    dec->color = dec->palette[b >> 4];
+    dec->run = b & 0x0F;
+
+    if (dec->run == 0) {
+        uint32_t len = 0;
+        int shift = 0;
+        while (dec->pos < dec->end) {
+            uint8_t v = *dec->pos++;
+            len |= (uint32_t)(v & 0x7F) << shift;
+            shift += 7;
+            if (!(v & 0x80)) {
+                break;
+            }
+        }
+        dec->run = 16 + len;
+    }
+}
+
+void tft_image_decode(tft_image_decoder_t *dec, uint16_t *dst, uint32_t count) {
+    while (count > 0) {
+        if (dec->run == 0) {
+            tft_image_next_run(dec);
+        }
+
+        uint32_t n = dec->run < count ? dec->run : count;
+        if (dst) {
+            uint16_t px = dec->color;
+            for (uint32_t i = 0; i < n; i++) {
+                *dst++ = px;
+            }
+        }
+        dec->run -= n;
+        count -= n;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef TFT_IMAGE_H
+#define TFT_IMAGE_H
+
+#include <stdint.h>
+
+// Palette-indexed, run-length encoded image, produced by tools/img2tft.py.
+// Pixels are stored in raster order as runs that may cross row ends. Each run
+// starts with one byte: the high nibble is the palette index, the low nibble
+// the run length (1-15). A low nibble of 0 means the length is 16 plus an
+// unsigned LEB128 value in the following bytes.
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t palette_size;     // 1-16
+    const uint16_t *palette;  // RGB565
+    const uint8_t *data;      // Run stream
+    uint32_t data_size;       // Bytes in data[]
+} tft_image_t;
+
+#define TFT_IMAGE_MAX_COLORS 16
+
+// Streaming decoder. Output pixels are in panel byte order, ready for DMA.
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+    uint32_t run;             // Pixels left in the current run
+    uint16_t color;           // Current run's pixel
+    uint16_t palette[TFT_IMAGE_MAX_COLORS];
+} tft_image_decoder_t;
+
+void tft_image_decoder_init(tft_image_decoder_t *dec, const tft_image_t *img);
+
+// Writes the next `count` pixels to dst, or skips them when dst is NULL.
+// Past the end of the data the decoder yields palette entry 0.
+void tft_image_decode(tft_image_decoder_t *dec, uint16_t *dst, uint32_t count);
+
+#endif // TFT_IMAGE_H
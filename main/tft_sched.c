@@ -0,0 +1,204 @@
+#include <string.h>
+#include "tft_sched.h"
+#include "tft_driver.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "freertos/task.h"
+
+#ifndef CONFIG_TFT_FRAME_RATE
+#define CONFIG_TFT_FRAME_RATE 30
+#endif
+
+#define TFT_SCHED_TASK_STACK    4096
+#define TFT_SCHED_TASK_PRIO     11  // Above the encoder task so slots start on time
+#define TFT_SCHED_TE_TIMEOUT_MS 100 // No TE pulse for six refreshes means the pin isn't wired
+
+static const char *TAG = "TFT_SCHED";
+
+static TaskHandle_t sched_task;
+static esp_timer_handle_t sched_timer;
+static gpio_num_t te_pin = GPIO_NUM_NC;
+static bool sched_te;                  // Slots come from TE pulses
+static volatile bool running;
+static volatile int64_t slot_us;       // Time of the latest slot
+static volatile uint32_t te_divider;   // TE pulses per slot
+static volatile uint32_t te_count;
+static volatile int64_t te_pulse_us;   // Time of the latest TE pulse, slot or not
+static int sched_fps;
+static tft_sched_config_t cfg;
+static tft_sched_stats_t stats;
+
+// --- Tick sources ---
+static void IRAM_ATTR tft_sched_te_isr(void *arg) {
+    te_pulse_us = esp_timer_get_time();
+    if (!running || ++te_count < te_divider) {
+        return;
+    }
+    te_count = 0;
+    slot_us = esp_timer_get_time();
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(sched_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void tft_sched_timer_cb(void *arg) {
+    slot_us = esp_timer_get_time();
+    xTaskNotifyGive(sched_task);
+}
+
+// Called with the lock held once a TE-paced run has seen no pulses
+static void tft_sched_use_timer(void) {
+    ESP_LOGW(TAG, "No TE pulses on GPIO %d, pacing with a timer", te_pin);
+    gpio_isr_handler_remove(te_pin);
+    tft_set_tearing_output(false);
+    sched_te = false;
+
+    stats.te = false;
+    stats.period_us = 1000000 / sched_fps;
+    esp_timer_start_periodic(sched_timer, stats.period_us);
+}
+
+// --- Scheduler task ---
+static void tft_sched_run_frame(uint32_t missed) {
+    tft_sched_frame_t frame = {
+        .index = stats.frames,
+        .slot_us = slot_us,
+        .deadline_us = slot_us + stats.period_us,
+        .missed = missed,
+    };
+
+    // Last slot's frame goes out first, ahead of the panel's scan
+    if (!cfg.deferred) {
+        tft_flush();
+    }
+    cfg.callback(&frame, cfg.arg);
+
+    int64_t end_us = esp_timer_get_time();
+    int64_t busy_us = end_us - frame.slot_us;
+    stats.frames++;
+    stats.missed += missed;
+    stats.busy_us += busy_us;
+    if (busy_us > stats.worst_us) stats.worst_us = busy_us;
+    if (end_us > frame.deadline_us) stats.overruns++;
+}
+
+// True while TE pulses keep coming, whatever the slot divider
+static bool tft_sched_te_alive(void) {
+    return esp_timer_get_time() - te_pulse_us < TFT_SCHED_TE_TIMEOUT_MS * 1000LL;
+}
+
+static void tft_sched_task(void *arg) {
+    for (;;) {
+        // A slot takes te_divider pulses: wait for one slot period plus the
+        // timeout (+1 tick, pdMS_TO_TICKS rounds down)
+        TickType_t wait = sched_te
+            ? pdMS_TO_TICKS(stats.period_us / 1000 + TFT_SCHED_TE_TIMEOUT_MS) + 1
+            : portMAX_DELAY;
+        uint32_t slots = ulTaskNotifyTake(pdTRUE, wait);
+        if (!running) {
+            continue;
+        }
+
+        SemaphoreHandle_t lock = cfg.lock;
+        if (lock) xSemaphoreTake(lock, portMAX_DELAY);
+        if (running) {
+            if (slots > 0) {
+                tft_sched_run_frame(slots - 1);
+            } else if (sched_te && !tft_sched_te_alive()) {
+                tft_sched_use_timer();
+            }
+        }
+        if (lock) xSemaphoreGive(lock);
+    }
+}
+
+// --- API ---
+esp_err_t tft_sched_init(int te_gpio) {
+    const esp_timer_create_args_t timer_args = {
+        .callback = tft_sched_timer_cb,
+        .name = "tft_sched",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &sched_timer));
+
+    if (xTaskCreate(tft_sched_task, "tft_sched", TFT_SCHED_TASK_STACK, NULL, TFT_SCHED_TASK_PRIO,
+                    &sched_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create scheduler task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (te_gpio >= 0) {
+        gpio_config_t io_conf = {
+            .pin_bit_mask = 1ULL << te_gpio,
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_POSEDGE,
+        };
+        ESP_ERROR_CHECK(gpio_config(&io_conf));
+
+        // The encoder may already have installed the shared ISR service
+        esp_err_t err = gpio_install_isr_service(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            return err;
+        }
+        ESP_ERROR_CHECK(gpio_isr_handler_add(te_gpio, tft_sched_te_isr, NULL));
+        tft_set_tearing_output(true);
+        te_pin = te_gpio;
+        sched_te = true;
+    }
+
+    ESP_LOGI(TAG, "Frame slots from %s", sched_te ? "TE pin" : "timer");
+    return ESP_OK;
+}
+
+void tft_sched_start(const tft_sched_config_t *config) {
+    if (running) {
+        tft_sched_stop();
+    }
+
+    cfg = *config;
+    sched_fps = cfg.fps > 0 ? cfg.fps : CONFIG_TFT_FRAME_RATE;
+    if (sched_fps > TFT_SCHED_PANEL_HZ) sched_fps = TFT_SCHED_PANEL_HZ;
+
+    // With TE the rate snaps to a whole number of panel refreshes per frame
+    te_divider = (TFT_SCHED_PANEL_HZ + sched_fps / 2) / sched_fps;
+    te_count = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.te = sched_te;
+    stats.period_us = sched_te ? te_divider * 1000000LL / TFT_SCHED_PANEL_HZ : 1000000 / sched_fps;
+
+    running = true;
+    if (!sched_te) {
+        esp_timer_start_periodic(sched_timer, stats.period_us);
+    }
+}
+
+void tft_sched_stop(void) {
+    if (!running) {
+        return;
+    }
+    running = false;
+    if (!sched_te) {
+        esp_timer_stop(sched_timer);
+    }
+    tft_sched_log_stats();
+}
+
+bool tft_sched_is_running(void) {
+    return running;
+}
+
+void tft_sched_get_stats(tft_sched_stats_t *out) {
+    *out = stats;
+}
+
+void tft_sched_log_stats(void) {
+    ESP_LOGI(TAG, "%lu frames at %lld us (%s): %lu overruns, %lu missed slots, busy avg %lld us, worst %lld us",
+             (unsigned long)stats.frames, (long long)stats.period_us, stats.te ? "TE" : "timer",
+             (unsigned long)stats.overruns, (unsigned long)stats.missed,
+             (long long)(stats.frames ? stats.busy_us / stats.frames : 0), (long long)stats.worst_us);
+}
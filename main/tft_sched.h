@@ -0,0 +1,63 @@
+#ifndef TFT_SCHED_H
+#define TFT_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// Frame pacing for animations. Each frame slot starts on a pulse of the
+// panel's tearing-effect (TE) output, i.e. at the start of vertical blanking,
+// or on an esp_timer tick when TE isn't wired. At every slot the scheduler
+// task first flushes the frame rendered during the previous slot, so the
+// transfer starts ahead of the panel's scan, then calls the frame callback
+// to draw the next one. In direct mode the callback's drawing reaches the
+// panel immediately, so only the pacing applies.
+
+// Panel refresh rate the TE pulses follow (ST7789 default, FRCTRL2 = 0x0F)
+#define TFT_SCHED_PANEL_HZ 60
+
+typedef struct {
+    uint32_t index;      // Frames since tft_sched_start()
+    int64_t slot_us;     // Start of this frame slot
+    int64_t deadline_us; // Start of the next slot, when this frame is flushed
+    uint32_t missed;     // Slots skipped since the previous frame
+} tft_sched_frame_t;
+
+typedef void (*tft_sched_cb_t)(const tft_sched_frame_t *frame, void *arg);
+
+typedef struct {
+    int fps;                 // 0 = CONFIG_TFT_FRAME_RATE; rounded to a TE divider
+    tft_sched_cb_t callback; // Draws the next frame; must not flush
+    void *arg;
+    SemaphoreHandle_t lock;  // Held around each flush + callback (may be NULL)
+    bool deferred;           // Callback only hands the slot to a render task,
+                             // which flushes and draws there; no flush here
+} tft_sched_config_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t overruns;   // Frames whose callback finished after their deadline
+    uint32_t missed;     // Slots skipped because a frame ran late
+    int64_t busy_us;     // Flush + callback time, summed over all frames
+    int64_t worst_us;    // Longest flush + callback
+    int64_t period_us;
+    bool te;             // Paced by the TE pin rather than the timer
+} tft_sched_stats_t;
+
+// Sets up the tick source and the scheduler task. te_gpio < 0 uses the
+// timer; if the TE pin stays silent after tft_sched_start(), the scheduler
+// also falls back to the timer. Call after tft_init_driver().
+esp_err_t tft_sched_init(int te_gpio);
+
+// Starts calling config->callback once per frame slot, resetting the stats.
+// Stopping takes effect before the next callback; call both with the lock held.
+void tft_sched_start(const tft_sched_config_t *config);
+void tft_sched_stop(void);
+bool tft_sched_is_running(void);
+
+void tft_sched_get_stats(tft_sched_stats_t *out);
+void tft_sched_log_stats(void);
+
+#endif
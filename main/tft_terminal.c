@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "tft_terminal.h"
+#include "tft_driver.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+
+#define TERM_COLS      (TFT_WIDTH / 6)  // tft_font_6x8 cells
+#define TERM_LINE_H    10               // 8 px glyphs + 2 px gap that is never drawn
+#define TERM_QUEUE_LEN 2048             // Bytes of pending/recent text
+#define TERM_TAB_WIDTH 4
+
+// Screen state. Line slots are fixed panel rows; the hardware scroll decides
+// which slot is shown first.
+static bool term_open;
+static int term_top;
+static int term_rows;
+static int term_first;           // Slot shown at the top of the area
+static int term_used;            // Slots holding text
+static uint16_t term_fg, term_bg;
+static char term_line[TERM_COLS + 1];
+static int term_len;
+static bool term_dirty;          // Cursor line changed since it was drawn
+static bool term_newline;        // A line break is due before the next character
+static bool term_in_escape;      // Skipping an ANSI colour sequence
+
+// Pending text, filled from any task. When full the oldest line is dropped.
+static char queue[TERM_QUEUE_LEN];
+static size_t queue_head, queue_tail; // Free-running indices
+static portMUX_TYPE queue_lock = portMUX_INITIALIZER_UNLOCKED;
+static vprintf_like_t log_next_vprintf;
+
+static int tft_terminal_slot_y(int slot) {
+    return term_top + slot * TERM_LINE_H;
+}
+
+static void tft_terminal_draw_cursor_line(void) {
+    char padded[TERM_COLS + 1];
+    int slot = (term_first + term_used - 1) % term_rows;
+
+    // Full-width opaque text: one window, no separate clear of the old line
+    memset(padded, ' ', TERM_COLS);
+    memcpy(padded, term_line, term_len);
+    padded[TERM_COLS] = '\0';
+
+    const tft_font_t *prev = tft_get_font();
+    tft_set_font(&tft_font_6x8);
+    tft_draw_text_bg(1, tft_terminal_slot_y(slot), padded, 1, term_fg, term_bg);
+    tft_set_font(prev);
+    term_dirty = false;
+}
+
+static void tft_terminal_line_break(void) {
+    if (term_dirty) {
+        tft_terminal_draw_cursor_line();
+    }
+
+    if (term_used < term_rows) {
+        term_used++;
+    } else {
+        // The top line scrolls away and its slot becomes the bottom line
+        term_first = (term_first + 1) % term_rows;
+        tft_scroll_to(term_first * TERM_LINE_H);
+    }
+    term_len = 0;
+    term_dirty = true;
+}
+
+static void tft_terminal_putc(char c) {
+    if (term_in_escape) {
+        // CSI sequences end with a byte in '@'..'~' (the '[' itself is skipped too)
+        if (c != '[' && c >= '@' && c <= '~') {
+            term_in_escape = false;
+        }
+        return;
+    }
+
+    switch (c) {
+        case '\033':
+            term_in_escape = true;
+            return;
+        case '\n':
+            term_newline = true;
+            return;
+        case '\r':
+            term_len = 0;
+            term_dirty = true;
+            return;
+        case '\t':
+            do {
+                tft_terminal_putc(' ');
+            } while (term_len % TERM_TAB_WIDTH != 0 && term_len < TERM_COLS);
+            return;
+    }
+
+    if (term_newline || term_used == 0) {
+        term_newline = false;
+        tft_terminal_line_break();
+    } else if (term_len == TERM_COLS) {
+        tft_terminal_line_break(); // Wrap
+    }
+
+    term_line[term_len++] = (c >= ' ' && c <= '~') ? c : '?';
+    term_dirty = true;
+}
+
+void tft_terminal_write(const char *text) {
+    if (!term_open) {
+        return;
+    }
+    for (const char *p = text; *p; p++) {
+        tft_terminal_putc(*p);
+    }
+    if (term_dirty && term_used > 0) {
+        tft_terminal_draw_cursor_line();
+    }
+}
+
+void tft_terminal_printf(const char *fmt, ...) {
+    char buf[128];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    tft_terminal_write(buf);
+}
+
+void tft_terminal_post(const char *text) {
+    size_t len = strlen(text);
+    if (len >= TERM_QUEUE_LEN) {
+        text += len - (TERM_QUEUE_LEN - 1);
+        len = TERM_QUEUE_LEN - 1;
+    }
+
+    portENTER_CRITICAL(&queue_lock);
+    if (queue_head - queue_tail + len > TERM_QUEUE_LEN) {
+        // Drop whole lines from the front to make room
+        queue_tail = queue_head + len - TERM_QUEUE_LEN;
+        while (queue_tail != queue_head && queue[queue_tail++ % TERM_QUEUE_LEN] != '\n') {
+        }
+    }
+    for (size_t i = 0; i < len; i++) {
+        queue[queue_head++ % TERM_QUEUE_LEN] = text[i];
+    }
+    portEXIT_CRITICAL(&queue_lock);
+}
+
+bool tft_terminal_update(void) {
+    char chunk[65];
+    bool drawn = false;
+
+    if (!term_open) {
+        return false;
+    }
+
+    for (;;) {
+        size_t n = 0;
+        portENTER_CRITICAL(&queue_lock);
+        while (n < sizeof(chunk) - 1 && queue_tail != queue_head) {
+            chunk[n++] = queue[queue_tail++ % TERM_QUEUE_LEN];
+        }
+        portEXIT_CRITICAL(&queue_lock);
+
+        if (n == 0) {
+            return drawn;
+        }
+        chunk[n] = '\0';
+        tft_terminal_write(chunk);
+        drawn = true;
+    }
+}
+
+static int tft_terminal_vprintf(const char *fmt, va_list args) {
+    char buf[160];
+    va_list copy;
+
+    va_copy(copy, args);
+    vsnprintf(buf, sizeof(buf), fmt, copy);
+    va_end(copy);
+    tft_terminal_post(buf);
+
+    return log_next_vprintf ? log_next_vprintf(fmt, args) : 0;
+}
+
+void tft_terminal_attach_log(void) {
+    if (log_next_vprintf == NULL) {
+        log_next_vprintf = esp_log_set_vprintf(tft_terminal_vprintf);
+    }
+}
+
+void tft_terminal_open(int top, uint16_t fg, uint16_t bg) {
+    term_rows = (TFT_HEIGHT - top) / TERM_LINE_H;
+    term_top = TFT_HEIGHT - term_rows * TERM_LINE_H;
+    term_fg = fg;
+    term_bg = bg;
+    term_first = 0;
+    term_used = 0;
+    term_len = 0;
+    term_dirty = false;
+    term_newline = false;
+    term_in_escape = false;
+
+    // Page transition: slide whatever is on screen out of the area
+    tft_scroll_define(term_top, term_rows * TERM_LINE_H);
+    tft_scroll_smooth(term_rows * TERM_LINE_H, 2 * TERM_LINE_H, 16, bg);
+    tft_scroll_to(0);
+    term_open = true;
+}
+
+void tft_terminal_close(void) {
+    if (!term_open) {
+        return;
+    }
+    tft_scroll_reset();
+    term_open = false;
+}
+
+bool tft_terminal_is_open(void) {
+    return term_open;
+}
@@ -0,0 +1,34 @@
+#ifndef TFT_TERMINAL_H
+#define TFT_TERMINAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Scrolling text console drawn with the panel's hardware vertical scroll. A
+// new line moves the scroll start address and redraws only that line, so
+// scrolling costs one text row of pixels instead of repainting the area.
+//
+// Drawing calls (open/close/write/printf/update) belong to whichever task owns
+// the display. tft_terminal_post() and the ESP_LOG mirror only append to a
+// ring buffer, so any task may use them; tft_terminal_update() draws it.
+
+// Takes over display rows [top, TFT_HEIGHT) and slides the old content out
+void tft_terminal_open(int top, uint16_t fg, uint16_t bg);
+// Leaves scroll mode; the caller redraws the screen
+void tft_terminal_close(void);
+bool tft_terminal_is_open(void);
+
+void tft_terminal_write(const char *text);
+void tft_terminal_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Thread-safe: queue text for the next tft_terminal_update()
+void tft_terminal_post(const char *text);
+// Draws queued text; returns true if anything was drawn
+bool tft_terminal_update(void);
+
+// Mirrors ESP_LOG output into the queue (the UART still gets everything).
+// The most recent output is kept while the terminal is closed and shown when
+// it opens.
+void tft_terminal_attach_log(void);
+
+#endif
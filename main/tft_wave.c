@@ -0,0 +1,178 @@
+#include <string.h>
+#include "tft_wave.h"
+
+#define WAVE_MERGE_SLACK 128 // Unchanged pixels worth resending to save a window (~50 us of commands)
+
+// Changed rows of the column being updated
+typedef struct {
+    int y1, y2; // y1 > y2 = unchanged
+} wave_span_t;
+
+static int16_t new_lo[TFT_WIDTH], new_hi[TFT_WIDTH]; // Too large for task stacks
+static wave_span_t spans[TFT_WIDTH];
+
+static void tft_wave_fill_row(const tft_region_t *src, int x, int y, int w, uint16_t *dst);
+
+void tft_wave_init(tft_wave_t *wave, int x, int y, int w, int h, uint16_t fg, uint16_t bg) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > TFT_WIDTH) w = TFT_WIDTH - x;
+    if (y + h > TFT_HEIGHT) h = TFT_HEIGHT - y;
+
+    wave->region.fill_row = tft_wave_fill_row;
+    wave->x = x;
+    wave->y = y;
+    wave->w = w > 0 ? w : 0;
+    wave->h = h > 0 ? h : 0;
+    wave->fg = fg;
+    wave->bg = bg;
+    wave->axis_y = -1;
+    wave->drawn = false;
+}
+
+void tft_wave_set_axis(tft_wave_t *wave, int y, uint16_t color) {
+    wave->axis_y = (y >= wave->y && y < wave->y + wave->h) ? y : -1;
+    wave->axis_color = color;
+    wave->drawn = false;
+}
+
+void tft_wave_invalidate(tft_wave_t *wave) {
+    wave->drawn = false;
+}
+
+void tft_wave_mark_clear(tft_wave_t *wave) {
+    for (int c = 0; c < wave->w; c++) {
+        wave->lo[c] = 1;
+        wave->hi[c] = 0;
+    }
+    wave->drawn = true;
+}
+
+static uint16_t tft_wave_color(const tft_wave_t *wave, int col, int row) {
+    if (row == wave->axis_y) {
+        return wave->axis_color;
+    }
+    return (row >= wave->lo[col] && row <= wave->hi[col]) ? wave->fg : wave->bg;
+}
+
+// Region source: the trace as the wave currently holds it
+static void tft_wave_fill_row(const tft_region_t *src, int x, int y, int w, uint16_t *dst) {
+    const tft_wave_t *wave = (const tft_wave_t *)src;
+    for (int c = x - wave->x; c < x - wave->x + w; c++) {
+        *dst++ = TFT_SWAP16(tft_wave_color(wave, c, y));
+    }
+}
+
+// Rows that differ between two runs (bounding range of their symmetric difference)
+static wave_span_t tft_wave_diff(int olo, int ohi, int nlo, int nhi) {
+    if (olo > ohi) {
+        return (wave_span_t){nlo, nhi};
+    }
+    if (olo == nlo && ohi == nhi) {
+        return (wave_span_t){1, 0};
+    }
+    if (olo == nlo) {
+        return (wave_span_t){(ohi < nhi ? ohi : nhi) + 1, ohi > nhi ? ohi : nhi};
+    }
+    if (ohi == nhi) {
+        return (wave_span_t){olo < nlo ? olo : nlo, (olo > nlo ? olo : nlo) - 1};
+    }
+    return (wave_span_t){olo < nlo ? olo : nlo, ohi > nhi ? ohi : nhi};
+}
+
+// Neighbouring changed columns are merged into one region while the
+// unchanged pixels it resends stay below WAVE_MERGE_SLACK
+static void tft_wave_write_regions(const tft_wave_t *wave) {
+    int bx1 = -1, bx2 = 0, by1 = 0, by2 = 0, used = 0;
+
+    for (int c = 0; c < wave->w; c++) {
+        const wave_span_t *s = &spans[c];
+        if (s->y1 > s->y2) {
+            continue;
+        }
+
+        if (bx1 >= 0) {
+            int y1 = s->y1 < by1 ? s->y1 : by1;
+            int y2 = s->y2 > by2 ? s->y2 : by2;
+            int waste = (c - bx1 + 1) * (y2 - y1 + 1) - used - (s->y2 - s->y1 + 1);
+            if (waste <= WAVE_MERGE_SLACK) {
+                bx2 = c;
+                by1 = y1;
+                by2 = y2;
+                used += s->y2 - s->y1 + 1;
+                continue;
+            }
+            tft_draw_region(wave->x + bx1, by1, bx2 - bx1 + 1, by2 - by1 + 1, &wave->region);
+        }
+        bx1 = bx2 = c;
+        by1 = s->y1;
+        by2 = s->y2;
+        used = s->y2 - s->y1 + 1;
+    }
+
+    if (bx1 >= 0) {
+        tft_draw_region(wave->x + bx1, by1, bx2 - bx1 + 1, by2 - by1 + 1, &wave->region);
+    }
+}
+
+// Retained frames: one 1 px wide fill per run of equal color in each span, so
+// unchanged columns diff as unchanged
+static void tft_wave_write_spans(const tft_wave_t *wave) {
+    for (int c = 0; c < wave->w; c++) {
+        const wave_span_t *s = &spans[c];
+        int start = s->y1;
+
+        for (int row = s->y1; row <= s->y2; row++) {
+            uint16_t color = tft_wave_color(wave, c, row);
+            if (row == s->y2 || tft_wave_color(wave, c, row + 1) != color) {
+                tft_draw_filled_rect(wave->x + c, start, 1, row - start + 1, color);
+                start = row + 1;
+            }
+        }
+    }
+}
+
+void tft_wave_draw(tft_wave_t *wave, const int16_t *samples) {
+    if (wave->w == 0 || wave->h == 0) {
+        return;
+    }
+
+    int top = wave->y;
+    int bottom = wave->y + wave->h - 1;
+
+    if (!wave->drawn) {
+        tft_draw_filled_rect(wave->x, wave->y, wave->w, wave->h, wave->bg);
+        if (wave->axis_y >= 0) {
+            tft_draw_h_line(wave->x, wave->axis_y, wave->w, wave->axis_color);
+        }
+        tft_wave_mark_clear(wave);
+    }
+
+    // Each column runs from its sample to just short of the previous one
+    int prev = 0;
+    for (int c = 0; c < wave->w; c++) {
+        int s = samples[c] < top ? top : (samples[c] > bottom ? bottom : samples[c]);
+        if (c == 0 || s == prev) {
+            new_lo[c] = new_hi[c] = s;
+        } else if (s > prev) {
+            new_lo[c] = prev + 1;
+            new_hi[c] = s;
+        } else {
+            new_lo[c] = s;
+            new_hi[c] = prev - 1;
+        }
+        prev = s;
+        spans[c] = tft_wave_diff(wave->lo[c], wave->hi[c], new_lo[c], new_hi[c]);
+    }
+
+    // Regions read the new trace when rendered, which in band mode is at the
+    // next flush
+    memcpy(wave->lo, new_lo, wave->w * sizeof(int16_t));
+    memcpy(wave->hi, new_hi, wave->w * sizeof(int16_t));
+
+    if (tft_frame_is_recording()) {
+        tft_wave_write_spans(wave);
+    } else {
+        tft_wave_write_regions(wave);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef TFT_WAVE_H
+#define TFT_WAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tft_driver.h"
+
+// Oscilloscope-style trace that owns a screen area. Every column shows the
+// trace as one vertical run joining its sample to the previous column's, on
+// the background, with an optional axis row on top. tft_wave_draw() keeps
+// the rows it drew per column and rewrites only the rows that changed, as
+// pixel regions (tft_draw_region()) in which neighbouring changed columns
+// share one address window. They are clipped and recorded like any other
+// drawing, so in band mode the wave must stay valid until the next flush.
+typedef struct {
+    tft_region_t region;    // Pixel source of the changed columns
+    int x, y, w, h;
+    uint16_t fg, bg;
+    int axis_y;             // Screen row drawn in axis_color, -1 = none
+    uint16_t axis_color;
+    bool drawn;             // The area shows the last frame
+    int16_t lo[TFT_WIDTH];  // Trace rows drawn per column (lo > hi = none)
+    int16_t hi[TFT_WIDTH];
+} tft_wave_t;
+
+// The area is cleared by the first tft_wave_draw()
+void tft_wave_init(tft_wave_t *wave, int x, int y, int w, int h, uint16_t fg, uint16_t bg);
+void tft_wave_set_axis(tft_wave_t *wave, int y, uint16_t color);
+// Something else drew over the area: the next draw repaints it in full
+void tft_wave_invalidate(tft_wave_t *wave);
+// The area was just cleared to the background (and axis): the next draw
+// only adds the trace
+void tft_wave_mark_clear(tft_wave_t *wave);
+// samples[i] is the screen row of column x + i (w samples), clamped to the area
+void tft_wave_draw(tft_wave_t *wave, const int16_t *samples);
+
+#endif
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+"""Converts an image into a tft_image_t (see main/tft_image.h).
+
+Reads binary PPM (P6) or 8-bit non-interlaced PNG, reduces it to at most 16
+RGB565 colours and writes palette-indexed run-length data as a C source file.
+
+    tools/img2tft.py art.png -n img_vault_tec -o main/tft_asset_vault_tec.c
+    tools/img2tft.py shot.ppm -n img_logo --crop 70,75,181,91 -o logo.c
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAX_COLORS = 16
+
+
+def read_ppm(data):
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    if fields[0] != b'P6' or int(fields[3]) != 255:
+        sys.exit('only 8-bit binary PPM (P6) is supported')
+    w, h = int(fields[1]), int(fields[2])
+    px = data[pos + 1:pos + 1 + w * h * 3]
+    return w, h, [tuple(px[i:i + 3]) for i in range(0, len(px), 3)]
+
+
+def read_png(data):
+    pos = 8
+    idat = b''
+    palette = None
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if kind == b'IHDR':
+            w, h, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'IDAT':
+            idat += body
+        pos += 12 + length
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    if depth != 8 or interlace:
+        sys.exit('only 8-bit non-interlaced PNG is supported')
+
+    raw = zlib.decompress(idat)
+    stride = w * channels
+    prev = bytearray(stride)
+    pixels = []
+    for y in range(h):
+        ftype = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        for x in range(w):
+            v = line[x * channels:(x + 1) * channels]
+            if ctype == 3:
+                pixels.append(palette[v[0]])
+            elif channels <= 2:
+                pixels.append((v[0], v[0], v[0]))
+            else:
+                pixels.append(tuple(v[:3]))
+        prev = line
+    return w, h, pixels
+
+
+def rgb565(rgb):
+    r, g, b = rgb
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def build_palette(colors):
+    counts = {}
+    for c in colors:
+        counts[c] = counts.get(c, 0) + 1
+    # Black first when present, so areas past the data decode as background
+    palette = sorted(counts, key=lambda c: (c != 0, -counts[c]))
+    if len(palette) > MAX_COLORS:
+        print(f'warning: {len(palette)} colours, keeping the {MAX_COLORS} most used',
+              file=sys.stderr)
+    return palette[:MAX_COLORS]
+
+
+def nearest(palette, c):
+    def parts(v):
+        return (v >> 11, (v >> 5) & 0x3F, v & 0x1F)
+    r, g, b = parts(c)
+    return min(range(len(palette)), key=lambda i: sum(
+        (p - q) ** 2 for p, q in zip(parts(palette[i]), (r, g, b))))
+
+
+def encode(indices):
+    out = bytearray()
+    i = 0
+    while i < len(indices):
+        j = i
+        while j < len(indices) and indices[j] == indices[i]:
+            j += 1
+        n = j - i
+        if n < 16:
+            out.append(indices[i] << 4 | n)
+        else:
+            out.append(indices[i] << 4)
+            v = n - 16
+            while True:
+                out.append((v & 0x7F) | (0x80 if v > 0x7F else 0))
+                v >>= 7
+                if not v:
+                    break
+        i = j
+    return out
+
+
+def decode(data, count):
+    out = []
+    pos = 0
+    while pos < len(data) and len(out) < count:
+        b = data[pos]
+        pos += 1
+        n = b & 0x0F
+        if n == 0:
+            v, shift = 0, 0
+            while True:
+                x = data[pos]
+                pos += 1
+                v |= (x & 0x7F) << shift
+                shift += 7
+                if not x & 0x80:
+                    break
+            n = 16 + v
+        out.extend([b >> 4] * n)
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('input')
+    ap.add_argument('-n', '--name', required=True, help='C symbol of the tft_image_t')
+    ap.add_argument('-o', '--output', help='output .c file (default: stdout)')
+    ap.add_argument('--crop', help='x,y,w,h')
+    args = ap.parse_args()
+
+    data = open(args.input, 'rb').read()
+    w, h, pixels = read_png(data) if data[:8] == b'\x89PNG\r\n\x1a\n' else read_ppm(data)
+
+    if args.crop:
+        cx, cy, cw, ch = map(int, args.crop.split(','))
+        pixels = [pixels[(cy + y) * w + cx + x] for y in range(ch) for x in range(cw)]
+        w, h = cw, ch
+
+    colors = [rgb565(p) for p in pixels]
+    palette = build_palette(colors)
+    lookup = {c: nearest(palette, c) for c in set(colors)}
+    indices = [lookup[c] for c in colors]
+    rle = encode(indices)
+    assert decode(rle, len(indices)) == indices
+
+    lines = [
+        f'// Generated by tools/img2tft.py from {args.input.split("/")[-1]}. Do not edit.',
+        f'// {w}x{h}, {len(palette)} colours, {len(rle)} bytes of run data',
+        f'// ({w * h * 2} bytes as raw RGB565).',
+        '',
+        '#include "tft_image.h"',
+        '',
+        f'static const uint16_t {args.name}_palette[] = {{',
+        '    ' + ', '.join(f'0x{c:04X}' for c in palette) + ',',
+        '};',
+        '',
+        f'static const uint8_t {args.name}_data[] = {{',
+    ]
+    for i in range(0, len(rle), 16):
+        lines.append('    ' + ', '.join(f'0x{b:02X}' for b in rle[i:i + 16]) + ',')
+    lines += [
+        '};',
+        '',
+        f'const tft_image_t {args.name} = {{',
+        f'    .width = {w},',
+        f'    .height = {h},',
+        f'    .palette_size = {len(palette)},',
+        f'    .palette = {args.name}_palette,',
+        f'    .data = {args.name}_data,',
+        f'    .data_size = sizeof({args.name}_data),',
+        '};',
+        '',
+    ]
+
+    text = '\n'.join(lines)
+    if args.output:
+        open(args.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+    print(f'{args.name}: {w}x{h}, {len(palette)} colours, {len(rle)} bytes', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()